@@ -26,6 +26,9 @@ def create_graph(map_path: str):
             EXE_PATH,
             "--map_path",
             map_path,
+            # Maps are already spread over the pool
+            "--threads",
+            "1",
         ],
         stdout=subprocess.PIPE,
         stderr=subprocess.PIPE,
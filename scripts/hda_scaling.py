@@ -0,0 +1,100 @@
+# hda_scaling.py
+# Report how the wall clock time of HDA* or parallel PRA* scales with the number of threads on the longest scenarios
+
+import argparse
+import csv
+import os
+import subprocess
+from multiprocessing import cpu_count
+
+SCRIPT_PATH = os.path.dirname(os.path.abspath(__file__))
+ROOT_PATH = os.path.dirname(SCRIPT_PATH)
+EXE_PATH = os.path.join(ROOT_PATH, "build", "Release", "src", "run_multi")
+EXPERIMENT_PATH = os.path.join(ROOT_PATH, "experiments", "hda_scaling")
+
+SCENARIO_FILE_EXTENSION = ".map.scen"
+
+
+def run_scenario(scenario_path: str, algorithm: str, num_threads: int) -> list:
+    file_name = os.path.basename(scenario_path)[: -len(SCENARIO_FILE_EXTENSION)]
+    experiment_full_path = os.path.join(
+        EXPERIMENT_PATH, file_name
+    ) + "_{}_{}.csv".format(algorithm, num_threads)
+
+    subprocess.run(
+        [
+            EXE_PATH,
+            "--scenario_path",
+            scenario_path,
+            "--export_path",
+            experiment_full_path,
+            "--algorithm",
+            algorithm,
+            "--threads",
+            str(num_threads),
+        ],
+        stdout=subprocess.DEVNULL,
+        check=True,
+    )
+
+    with open(experiment_full_path) as export_file:
+        return list(csv.DictReader(export_file))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--scenario_path", required=True, help="Scenario file to run")
+    parser.add_argument(
+        "--max_threads", type=int, default=cpu_count(), help="Largest thread count"
+    )
+    parser.add_argument(
+        "--buckets", type=int, default=5, help="Number of longest buckets to report"
+    )
+    parser.add_argument(
+        "--algorithm",
+        default="hda",
+        choices=["hda", "pra_parallel"],
+        help="Parallel algorithm to scale",
+    )
+    args = parser.parse_args()
+
+    if not os.path.exists(EXPERIMENT_PATH):
+        os.makedirs(EXPERIMENT_PATH)
+
+    # Powers of two up to the thread count, buckets are 4 units of optimal cost as in the scenario files
+    thread_counts = [1]
+    while thread_counts[-1] * 2 <= args.max_threads:
+        thread_counts.append(thread_counts[-1] * 2)
+    if thread_counts[-1] != args.max_threads:
+        thread_counts.append(args.max_threads)
+
+    runs = [("astar", 1)] + [
+        (args.algorithm, num_threads) for num_threads in thread_counts
+    ]
+    results = dict()
+    for algorithm, num_threads in runs:
+        rows = run_scenario(args.scenario_path, algorithm, num_threads)
+        max_bucket = max(int(float(row["optimal_cost"]) / 4) for row in rows)
+        long_rows = [
+            row
+            for row in rows
+            if int(float(row["optimal_cost"]) / 4) > max_bucket - args.buckets
+        ]
+        results[(algorithm, num_threads)] = (
+            sum(float(row["duration"]) for row in long_rows) / len(long_rows),
+            sum(int(row["expanded"]) for row in long_rows) / len(long_rows),
+            len(long_rows),
+        )
+
+    base_duration = results[(args.algorithm, 1)][0]
+    print("algorithm,threads,queries,mean_duration,mean_expanded,speedup")
+    for (algorithm, num_threads), (duration, expanded, count) in results.items():
+        print(
+            "{},{},{},{:.6f},{:.1f},{:.2f}".format(
+                algorithm, num_threads, count, duration, expanded, base_duration / duration
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
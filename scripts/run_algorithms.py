@@ -15,7 +15,7 @@ EXPERIMENT_PATH = os.path.join(ROOT_PATH, "experiments")
 MAP_BASE_PATH = os.path.join(ROOT_PATH, "scenarios")
 
 SCENARIO_FILE_EXTENSION = ".map.scen"
-ALGORITHMS = ["astar", "pra"]
+ALGORITHMS = ["astar", "astar_alt", "bidir_astar", "ara", "ha", "fringe", "sma", "jps", "jps_plus", "pra"]
 K_PARAMS = [0, 2, 4, 8, 16]
 
 
@@ -57,6 +57,30 @@ def run_all_scenarios(scenario_path: str):
     # Run A*
     run_scenario(scenario_path, "astar", 0)
 
+    # Run A* with landmark heuristics
+    run_scenario(scenario_path, "astar_alt", 0)
+
+    # Run bidirectional A*
+    run_scenario(scenario_path, "bidir_astar", 0)
+
+    # Run ARA*, solutions over time are saved next to the results
+    run_scenario(scenario_path, "ara", 0)
+
+    # Run A* with abstract layer distances (HA*)
+    run_scenario(scenario_path, "ha", 0)
+
+    # Run Fringe search
+    run_scenario(scenario_path, "fringe", 0)
+
+    # Run SMA* without a node cap, the peak node counts are saved with the results
+    run_scenario(scenario_path, "sma", 0)
+
+    # Run JPS
+    run_scenario(scenario_path, "jps", 0)
+
+    # Run JPS+, jump table is loaded from disk or built on the fly
+    run_scenario(scenario_path, "jps_plus", 0)
+
     # Run PRA*
     for k in K_PARAMS:
         run_scenario(scenario_path, "pra", k)
@@ -4,161 +4,381 @@
 #include "a_star.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
-#include <cmath>
 #include <iostream>
-#include <memory>
+#include <type_traits>
 
-#include "util/priority_queue.h"
+#include "algorithm/common/grid_expansion.h"
 #include "util/timer.h"
 
 namespace tpl_search {
 
-constexpr double EPS = 1e-5;
+namespace {
 
-bool is_greater(double lhs, double rhs) {
-    return lhs > rhs + EPS;
+template <typename GraphT, typename CostT>
+std::vector<std::size_t> reconstruct_path(const GraphT &graph, const SearchWorkspace<CostT> &workspace,
+                                          std::size_t current_index) {
+    assert(current_index != NO_PARENT);
+    std::vector<std::size_t> path;
+    while (current_index != NO_PARENT) {
+        path.push_back(graph.get_node_id(current_index));
+        current_index = workspace.get_parent(current_index);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
-// Node used in search
-struct SearchNode {
-    const SearchNode *parent = nullptr;
-    const GraphNode *graph_node;
-    double g = 0;
-    double f = 0;
-
-    // Compare function for nodes (f-cost, then g-cost on tiebreaks)
-    struct CompareOrdered {
-        bool operator()(const SearchNode &left, const SearchNode &right) const {
-            return left.f < right.f || (left.f == right.f && left.g > right.g);
-        }
-    };
+// Expansions between checks of the time budget, as reading the thread clock costs about as much as an expansion
+constexpr std::size_t TIME_CHECK_INTERVAL = 64;
 
-    // Hashing
-    struct Hasher {
-        using is_transparent = void;
-        std::size_t operator()(const SearchNode &node) const {
-            return node.graph_node->id;
-        }
-        std::size_t operator()(const std::unique_ptr<SearchNode> &node) const {
-            return node->graph_node->id;
-        }
-        std::size_t operator()(std::size_t id) const {
-            return id;
-        }
-    };
+}    // namespace
 
-    // Node equality compare (underlying state) for closed
-    struct CompareEqual {
-        using is_transparent = void;
-        bool operator()(const SearchNode &left, const SearchNode &right) const {
-            return *left.graph_node == *right.graph_node;
-        }
-        bool operator()(const std::unique_ptr<SearchNode> &left, const std::unique_ptr<SearchNode> &right) const {
-            return *left->graph_node == *right->graph_node;
-        }
-        bool operator()(const SearchNode &left, std::size_t id) const {
-            return left.graph_node->id == id;
-        }
-        bool operator()(const std::unique_ptr<SearchNode> &left, std::size_t id) const {
-            return left->graph_node->id == id;
-        }
-        bool operator()(std::size_t id, const SearchNode &right) const {
-            return id == right.graph_node->id;
+template <typename GraphT, typename HeuristicT, typename CostT, template <typename, typename> class OpenListT,
+          typename TieBreakT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+AStarSearch<GraphT, HeuristicT, CostT, OpenListT, TieBreakT>::AStarSearch(const GraphT &graph, std::size_t start_index,
+                                                                         std::size_t goal_index,
+                                                                         const HeuristicT &heuristic,
+                                                                         SearchContext &context)
+    : graph(graph),
+      heuristic(heuristic),
+      goal_index(goal_index),
+      workspace(context.get_workspace<CostT>()),
+      open(workspace.template get_open<OpenListT<CostT, TieBreakT>>()),
+      closest_index(start_index),
+      closest_h(heuristic(start_index)) {
+    workspace.reset(graph.num_nodes());
+    workspace.generate(start_index, CostT{}, NO_PARENT);
+    open.push({start_index, CostT{}, CostT{} + closest_h});
+}
+
+template <typename GraphT, typename HeuristicT, typename CostT, template <typename, typename> class OpenListT,
+          typename TieBreakT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+AStarSearch<GraphT, HeuristicT, CostT, OpenListT, TieBreakT>::AStarSearch(const GraphT &graph,
+                                                                         const std::vector<std::size_t> &start_indices,
+                                                                         const std::vector<std::size_t> &goal_indices,
+                                                                         const HeuristicT &heuristic,
+                                                                         SearchContext &context)
+    : graph(graph),
+      heuristic(heuristic),
+      goal_index(goal_indices.front()),
+      workspace(context.get_workspace<CostT>()),
+      open(workspace.template get_open<OpenListT<CostT, TieBreakT>>()),
+      closest_index(start_indices.front()),
+      closest_h(heuristic(start_indices.front())) {
+    assert(!start_indices.empty() && !goal_indices.empty());
+    if (goal_indices.size() > 1) {
+        sorted_goal_indices = goal_indices;
+        std::sort(sorted_goal_indices.begin(), sorted_goal_indices.end());
+    }
+    workspace.reset(graph.num_nodes());
+    for (const std::size_t start_index : start_indices) {
+        if (workspace.is_generated(start_index)) {
+            continue;
         }
-        bool operator()(std::size_t id, const std::unique_ptr<SearchNode> &right) const {
-            return id == right->graph_node->id;
+        const CostT h = heuristic(start_index);
+        workspace.generate(start_index, CostT{}, NO_PARENT);
+        open.push({start_index, CostT{}, CostT{} + h});
+        if (h < closest_h) {
+            closest_index = start_index;
+            closest_h = h;
         }
-    };
-};
-
-std::vector<std::size_t> reconstruct_path(const SearchNode *current_node) {
-    assert(current_node);
-    std::vector<std::size_t> path;
-    while (current_node) {
-        path.push_back(current_node->graph_node->id);
-        current_node = current_node->parent;
     }
-    std::reverse(path.begin(), path.end());
-    return path;
 }
 
-SearchOutput a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos) {
-    PrioritySet<SearchNode, SearchNode::CompareOrdered, SearchNode::Hasher> open;
-    std::unordered_set<std::unique_ptr<SearchNode>, SearchNode::Hasher, SearchNode::CompareEqual> closed;
-    std::vector<std::size_t> neighbour_ids;
+template <typename GraphT, typename HeuristicT, typename CostT, template <typename, typename> class OpenListT,
+          typename TieBreakT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+SearchStatus AStarSearch<GraphT, HeuristicT, CostT, OpenListT, TieBreakT>::run(const SearchBudget &budget) {
+    if (status != SearchStatus::InProgress) {
+        return status;
+    }
+    // Unlimited runs skip the budget checks and the tracking of the partial path
+    status = budget.is_limited() ? search<true>(budget) : search<false>(budget);
+#ifdef DEBUG
+    if (status == SearchStatus::Solved) {
+        std::cout << "Solution found. Solution cost: " << cost_to_double(workspace.get_g(goal_index))
+                  << ", Expanded: " << expanded << ", Generated: " << generated << ", Time: " << duration << "s"
+                  << std::endl;
+    } else if (status == SearchStatus::NoPath) {
+        std::cerr << "Exhausted search space, no solution found" << std::endl;
+    }
+#endif
+    return status;
+}
 
-    // Init
-    std::size_t expanded = 0;
-    std::size_t generated = 0;
+template <typename GraphT, typename HeuristicT, typename CostT, template <typename, typename> class OpenListT,
+          typename TieBreakT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+template <bool IS_LIMITED>
+SearchStatus AStarSearch<GraphT, HeuristicT, CostT, OpenListT, TieBreakT>::search(const SearchBudget &budget) {
+    using Node = SearchNode<CostT>;
 
-    ThreadTimer timer;
+    ThreadTimer timer(budget.seconds_limit);
     timer.start();
+    std::size_t run_expanded = 0;
+
+    // Keep the generated node closest to the goal as the end of the partial path
+    auto track_closest = [&](std::size_t index, const CostT &g, const CostT &f) {
+        if constexpr (IS_LIMITED) {
+            const CostT h = f - g;
+            if (h < closest_h) {
+                closest_index = index;
+                closest_h = h;
+            }
+        }
+    };
 
-    const GraphNode *start_node = graph.get_node(graph.get_pos_node_id(start_pos));
-    const GraphNode *goal_node = graph.get_node(graph.get_pos_node_id(goal_pos));
-    open.insert({nullptr, start_node, 0, 0 + distance(start_node, goal_node)});
     while (!open.empty()) {
-        SearchNode current = open.top();
-        closed.insert(std::make_unique<SearchNode>(open.top()));
-        open.pop();
-        const SearchNode *current_ptr = (*closed.find(current.graph_node->id)).get();
+        if constexpr (IS_LIMITED) {
+            if ((budget.max_expanded > 0 && run_expanded >= budget.max_expanded) ||
+                (budget.seconds_limit > 0 && run_expanded % TIME_CHECK_INTERVAL == 0 && timer.is_timeout())) {
+                duration += timer.get_duration();
+                return SearchStatus::InProgress;
+            }
+        }
+
+        const Node current = open.pop();
+        // Skip stale entries left behind by open lists which do not update in place
+        if (workspace.is_closed(current.index) || workspace.get_g(current.index) != current.g) {
+            continue;
+        }
+        workspace.close(current.index);
         ++expanded;
+        ++run_expanded;
 
-        // Goal check
-        if (current.graph_node == goal_node) {
-            double duration = timer.get_duration();
-            const SearchOutput search_output{expanded, generated, duration,
-                                             duration, current.g, reconstruct_path(current_ptr)};
-#ifdef DEBUG
-            std::cout << "Solution found. Solution length: " << search_output.path_node_ids.size()
-                      << ", solution cost: " << current.g << ", Expanded: " << expanded << ", Generated: " << generated
-                      << ", Time: " << duration << "s" << std::endl;
-#endif
-            return search_output;
+        // Goal check, the path is reconstructed from whichever goal is reached
+        if (current.index == goal_index ||
+            (!sorted_goal_indices.empty() &&
+             std::binary_search(sorted_goal_indices.begin(), sorted_goal_indices.end(), current.index))) {
+            goal_index = current.index;
+            duration += timer.get_duration();
+            return SearchStatus::Solved;
         }
 
-        auto consider_child = [&](SearchNode &child_node) -> bool {
-            // Check closed for re-expansion
-            auto closed_iter = closed.find(child_node.graph_node->id);
-            if (closed_iter != closed.end()) {
-                // Technically not needed for consistent heuristic
-                if (is_greater((*closed_iter)->g, child_node.g + EPS)) {
-                    closed.erase(closed_iter);
-                    open.insert(std::move(child_node));
-                    return true;
+        // The moves of the layer 0 grid under the octile heuristic are evaluated together
+        if constexpr (std::is_same_v<GraphT, GridGraphView> && std::is_same_v<HeuristicT, GridOctileHeuristic>) {
+            std::array<GridChild, NUM_GRID_MOVES> children;
+            const std::size_t num_children =
+                evaluate_grid_moves(graph, heuristic, workspace, current.index, current.g, children);
+            for (std::size_t i = 0; i < num_children; ++i) {
+                const GridChild &child = children[i];
+                // Closed nodes are only reopened for inconsistent heuristics, open nodes get a better path
+                const bool was_open = workspace.is_generated(child.index) && !workspace.is_closed(child.index);
+                workspace.generate(child.index, child.g, current.index);
+                if (was_open) {
+                    open.decrease({child.index, child.g, child.f});
+                } else {
+                    open.push({child.index, child.g, child.f});
                 }
+                track_closest(child.index, child.g, child.f);
+                ++generated;
             }
-            // Check open for better child found
-            else if (open.contains(child_node)) {
-                double g = open.get(child_node.graph_node->id).g;
-                if (is_greater(g, child_node.g)) {
-                    open.update(child_node);
-                    return true;
+        } else {
+            // Generate children one at a time, the heuristic is only evaluated for children which are pushed
+            graph.for_each_neighbour(current.index, [&](std::size_t child_index, const CostT &edge_cost) {
+                // Consistency can only be checked without rounding error
+                if constexpr (std::is_same_v<CostT, OctileCost>) {
+                    assert(!(heuristic(current.index) > edge_cost + heuristic(child_index)));
                 }
-            } else {
-                open.insert(std::move(child_node));
-                return true;
-            }
-            return false;
-        };
-
-        // Generate children
-        graph.get_neighbours(current.graph_node->id, neighbour_ids);
-        for (auto const &neighbour_id : neighbour_ids) {
-            const GraphNode *neighbour_node = graph.get_node(neighbour_id);
-            double delta_g = distance(current.graph_node, neighbour_node);
-            double child_g = current.g + delta_g;
-            double child_h = distance(neighbour_node, goal_node);
-            assert(!is_greater(current.f - current.g, delta_g + child_h));
-            SearchNode child_node{current_ptr, neighbour_node, child_g, child_g + child_h};
-            generated += consider_child(child_node);
+                const CostT child_g = current.g + edge_cost;
+                if (!workspace.is_generated(child_index)) {
+                    workspace.generate(child_index, child_g, current.index);
+                    const CostT child_f = child_g + heuristic(child_index);
+                    open.push({child_index, child_g, child_f});
+                    track_closest(child_index, child_g, child_f);
+                    ++generated;
+                    return;
+                }
+                // Closed nodes are only reopened for inconsistent heuristics, open nodes get a better path
+                if (!(child_g < workspace.get_g(child_index))) {
+                    return;
+                }
+                const bool was_closed = workspace.is_closed(child_index);
+                workspace.generate(child_index, child_g, current.index);
+                const Node child_node{child_index, child_g, child_g + heuristic(child_index)};
+                if (was_closed) {
+                    open.push(child_node);
+                } else {
+                    open.decrease(child_node);
+                }
+                ++generated;
+            });
         }
     }
-#ifdef DEBUG
-    std::cerr << "Exhausted search space, no solution found" << std::endl;
-#endif
-    return {expanded, generated, timer.get_duration(), -1, -1, {}};
+    duration += timer.get_duration();
+    return SearchStatus::NoPath;
+}
+
+template <typename GraphT, typename HeuristicT, typename CostT, template <typename, typename> class OpenListT,
+          typename TieBreakT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+SearchOutput AStarSearch<GraphT, HeuristicT, CostT, OpenListT, TieBreakT>::get_output() const {
+    switch (status) {
+        case SearchStatus::Solved:
+            return {expanded,
+                    generated,
+                    duration,
+                    duration,
+                    cost_to_double(workspace.get_g(goal_index)),
+                    reconstruct_path(graph, workspace, goal_index),
+                    {}};
+        case SearchStatus::NoPath:
+            return {expanded, generated, duration, -1, -1, {}, {}};
+        case SearchStatus::InProgress:
+            return {expanded,
+                    generated,
+                    duration,
+                    duration,
+                    cost_to_double(workspace.get_g(closest_index)),
+                    reconstruct_path(graph, workspace, closest_index),
+                    {},
+                    true};
+        default:
+            __builtin_unreachable();
+    }
+}
+
+template <typename GraphT, typename HeuristicT, typename CostT, template <typename, typename> class OpenListT,
+          typename TieBreakT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+SearchOutput a_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                           const HeuristicT &heuristic, SearchContext &context) {
+    AStarSearch<GraphT, HeuristicT, CostT, OpenListT, TieBreakT> search(graph, start_index, goal_index, heuristic,
+                                                                        context);
+    search.run();
+    return search.get_output();
+}
+
+// Layer 0 grids and abstract layers, with every open list and tie-breaking policy held by SearchWorkspace, the
+// layer 0 grid under the ALT and HA* heuristics, and both toward several goals
+#define PRA_INSTANTIATE_A_STAR(GRAPH, HEURISTIC, COST, OPEN_LIST, TIE_BREAK)                                \
+    template class AStarSearch<GRAPH, HEURISTIC, COST, OPEN_LIST, TIE_BREAK>;                             \
+    template SearchOutput a_star_search<GRAPH, HEURISTIC, COST, OPEN_LIST, TIE_BREAK>(                     \
+        const GRAPH &, std::size_t, std::size_t, const HEURISTIC &, SearchContext &);
+
+PRA_INSTANTIATE_A_STAR(GridGraphView, GridOctileHeuristic, OctileCost, HeapOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(GridGraphView, GridOctileHeuristic, OctileCost, HeapOpenList, TieBreakLowG)
+PRA_INSTANTIATE_A_STAR(GridGraphView, GridOctileHeuristic, OctileCost, BucketOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(GridGraphView, GridOctileHeuristic, OctileCost, BucketOpenList, TieBreakLowG)
+PRA_INSTANTIATE_A_STAR(AbstractGraphView, AbstractOctileHeuristic, double, HeapOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(AbstractGraphView, AbstractOctileHeuristic, double, HeapOpenList, TieBreakLowG)
+PRA_INSTANTIATE_A_STAR(AbstractGraphView, AbstractOctileHeuristic, double, BucketOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(AbstractGraphView, AbstractOctileHeuristic, double, BucketOpenList, TieBreakLowG)
+PRA_INSTANTIATE_A_STAR(GridGraphView, LandmarkHeuristic, OctileCost, HeapOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(GridGraphView, AbstractionHeuristic, OctileCost, HeapOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(GridGraphView, GridBoundsHeuristic, OctileCost, HeapOpenList, TieBreakHighG)
+PRA_INSTANTIATE_A_STAR(AbstractGraphView, AbstractBoundsHeuristic, double, HeapOpenList, TieBreakHighG)
+
+#undef PRA_INSTANTIATE_A_STAR
+
+SearchOutput a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                    SearchContext &context, OpenListType open_list_type) {
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        const GridOctileHeuristic heuristic(view, goal_index);
+        return open_list_type == OpenListType::BucketQueue
+                   ? a_star_search<GridGraphView, GridOctileHeuristic, OctileCost, BucketOpenList>(
+                         view, start_index, goal_index, heuristic, context)
+                   : a_star_search(view, start_index, goal_index, heuristic, context);
+    }
+    const AbstractGraphView view(graph);
+    const AbstractOctileHeuristic heuristic(view, goal_index);
+    return open_list_type == OpenListType::BucketQueue
+               ? a_star_search<AbstractGraphView, AbstractOctileHeuristic, double, BucketOpenList>(
+                     view, start_index, goal_index, heuristic, context)
+               : a_star_search(view, start_index, goal_index, heuristic, context);
+}
+
+SearchOutput a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                    const SearchBudget &budget, SearchContext &context) {
+    return a_star_nodes(graph, graph.get_pos_node_id(start_pos), graph.get_pos_node_id(goal_pos), budget, context);
+}
+
+SearchOutput a_star_nodes(const FlatGraph &graph, std::size_t start_id, std::size_t goal_id,
+                          const SearchBudget &budget, SearchContext &context,
+                          const std::unordered_set<std::size_t> *corridor) {
+    const std::size_t start_index = graph.get_node_index(start_id);
+    const std::size_t goal_index = graph.get_node_index(goal_id);
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph, corridor);
+        GridAStarSearch search(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), context);
+        search.run(budget);
+        return search.get_output();
+    }
+    const AbstractGraphView view(graph, corridor);
+    AStarSearch<AbstractGraphView, AbstractOctileHeuristic> search(view, start_index, goal_index,
+                                                                   AbstractOctileHeuristic(view, goal_index), context);
+    search.run(budget);
+    return search.get_output();
+}
+
+SearchOutput a_star_nodes(const FlatGraph &graph, const std::vector<std::size_t> &start_ids,
+                          const std::vector<std::size_t> &goal_ids, const SearchBudget &budget,
+                          SearchContext &context) {
+    if (start_ids.size() == 1 && goal_ids.size() == 1) {
+        return a_star_nodes(graph, start_ids.front(), goal_ids.front(), budget, context);
+    }
+    std::vector<std::size_t> start_indices, goal_indices;
+    for (const std::size_t start_id : start_ids) {
+        start_indices.push_back(graph.get_node_index(start_id));
+    }
+    for (const std::size_t goal_id : goal_ids) {
+        goal_indices.push_back(graph.get_node_index(goal_id));
+    }
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        AStarSearch<GridGraphView, GridBoundsHeuristic> search(view, start_indices, goal_indices,
+                                                               GridBoundsHeuristic(view, goal_indices), context);
+        search.run(budget);
+        return search.get_output();
+    }
+    const AbstractGraphView view(graph);
+    AStarSearch<AbstractGraphView, AbstractBoundsHeuristic> search(
+        view, start_indices, goal_indices, AbstractBoundsHeuristic(view, goal_indices), context);
+    search.run(budget);
+    return search.get_output();
+}
+
+GridAStarSearch make_grid_a_star_search(const FlatGraph &graph, const GridPosition &start_pos,
+                                        const GridPosition &goal_pos, SearchContext &context) {
+    assert(graph.is_grid_graph());
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    const GridGraphView view(graph);
+    return GridAStarSearch(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), context);
+}
+
+SearchOutput a_star(const FlatGraph &graph, const LandmarkTable &landmarks, const GridPosition &start_pos,
+                    const GridPosition &goal_pos, SearchContext &context) {
+    assert(graph.is_grid_graph() && landmarks.num_nodes() == graph.num_nodes());
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    const GridGraphView view(graph);
+    return a_star_search(view, start_index, goal_index, LandmarkHeuristic(view, landmarks, goal_index), context);
+}
+
+SearchOutput a_star(const FlatGraph &graph, const HomomorphicAbstraction &abstraction, const GridPosition &start_pos,
+                    const GridPosition &goal_pos, SearchContext &context) {
+    assert(graph.is_grid_graph());
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    const GridGraphView view(graph);
+    const AbstractionHeuristic heuristic(view, abstraction, goal_index,
+                                         context.get_workspace<OctileCost>(SearchDirection::Backward));
+    return a_star_search(view, start_index, goal_index, heuristic, context);
 }
 
 }    // namespace tpl_search
@@ -4,19 +4,208 @@
 #ifndef PRA_ALGORITHM_A_STAR_H
 #define PRA_ALGORITHM_A_STAR_H
 
+#include <unordered_set>
+#include <vector>
+
+#include "algorithm/common/abstraction_heuristic.h"
 #include "algorithm/common/graph.h"
+#include "algorithm/common/graph_view.h"
+#include "algorithm/common/landmarks.h"
+#include "algorithm/common/open_list.h"
+#include "algorithm/common/search_budget.h"
+#include "algorithm/common/search_concepts.h"
+#include "algorithm/common/search_context.h"
 #include "algorithm/common/search_output.h"
 
 namespace tpl_search {
 
+/**
+ * A* search over dense node indices which stops once its budget is spent and continues from there on the next run.
+ * The open list and node data stay in the workspace of the context between runs, so nothing else may search with the
+ * same workspace until this search is finished or abandoned.
+ * @note Instantiated for the same combinations as a_star_search
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType,
+          template <typename, typename> class OpenListT = HeapOpenList, typename TieBreakT = TieBreakHighG>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+class AStarSearch {
+public:
+    /**
+     * Start a search, no nodes are expanded until run
+     * @param graph The graph to search over, copied so views and heuristics may be temporaries
+     * @param start_index Dense index of the start node
+     * @param goal_index Dense index of the goal node
+     * @param heuristic Heuristic estimating the cost to the goal node
+     * @param context Search workspace held by the search until it is done
+     */
+    AStarSearch(const GraphT &graph, std::size_t start_index, std::size_t goal_index, const HeuristicT &heuristic,
+                SearchContext &context = get_thread_search_context());
+
+    /**
+     * Start a search from several start nodes to whichever of several goal nodes is reached first
+     * @param graph The graph to search over, copied so views and heuristics may be temporaries
+     * @param start_indices Dense indices of the start nodes, all starting at no cost
+     * @param goal_indices Dense indices of the goal nodes
+     * @param heuristic Heuristic estimating the cost to the nearest goal node
+     * @param context Search workspace held by the search until it is done
+     */
+    AStarSearch(const GraphT &graph, const std::vector<std::size_t> &start_indices,
+                const std::vector<std::size_t> &goal_indices, const HeuristicT &heuristic,
+                SearchContext &context = get_thread_search_context());
+
+    /**
+     * Expand nodes until the goal is reached, the search space is exhausted or the budget is spent
+     * @param budget Work allowed in this run, unlimited by default
+     * @return Status of the search after this run
+     */
+    SearchStatus run(const SearchBudget &budget = {});
+
+    SearchStatus get_status() const {
+        return status;
+    }
+
+    /**
+     * Get the results so far, the durations and counts cover every run
+     * @return Path to the goal once solved. While in progress, a partial path to the generated node with the lowest
+     * heuristic value, which is where the search has come closest to the goal.
+     */
+    SearchOutput get_output() const;
+
+private:
+    template <bool IS_LIMITED>
+    SearchStatus search(const SearchBudget &budget);
+
+    GraphT graph;
+    HeuristicT heuristic;
+    std::size_t goal_index;                          // The goal, or the goal reached once solved
+    std::vector<std::size_t> sorted_goal_indices;    // Every goal if there are several, empty otherwise
+    SearchWorkspace<CostT> &workspace;
+    OpenListT<CostT, TieBreakT> &open;
+    SearchStatus status = SearchStatus::InProgress;
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+    double duration = 0;
+    std::size_t closest_index;    // End of the partial path, only tracked by runs with a budget
+    CostT closest_h;
+};
+
+// A* search over the layer 0 grid which can be run in slices
+using GridAStarSearch = AStarSearch<GridGraphView, GridOctileHeuristic>;
+
+// A* search over an abstract layer which can be run in slices
+using AbstractAStarSearch = AStarSearch<AbstractGraphView, AbstractOctileHeuristic>;
+
+/**
+ * Perform A* search over dense node indices
+ * @note Only the combinations explicitly instantiated in a_star.cpp are available: the grid and abstract graph views
+ * with their octile heuristics, each with every open list and tie-breaking policy held by SearchWorkspace, and the
+ * grid graph view with LandmarkHeuristic or AbstractionHeuristic
+ * @param graph The graph to search over
+ * @param start_index Dense index of the start node
+ * @param goal_index Dense index of the goal node
+ * @param heuristic Heuristic estimating the cost to the goal node
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search, the path is given as node IDs
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType,
+          template <typename, typename> class OpenListT = HeapOpenList, typename TieBreakT = TieBreakHighG>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT> &&
+             SearchOpenList<OpenListT<CostT, TieBreakT>, CostT> && TieBreakPolicy<TieBreakT, CostT>
+SearchOutput a_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                           const HeuristicT &heuristic, SearchContext &context = get_thread_search_context());
+
 /**
  * Perform A* search
  * @param graph The graph to search over
  * @param start_pos The starting position
  * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @param open_list_type Open list implementation to use
+ * @return Results of search
+ */
+SearchOutput a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                    SearchContext &context = get_thread_search_context(),
+                    OpenListType open_list_type = OpenListType::PrioritySet);
+
+/**
+ * Perform A* search within a budget
+ * @param graph The graph to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param budget Work allowed for the search
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search, a partial path toward the goal if the budget ran out
+ */
+SearchOutput a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                    const SearchBudget &budget, SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform A* search between two nodes of a layer, the same search as between their positions
+ * @param graph The graph to search over
+ * @param start_id ID of the start node
+ * @param goal_id ID of the goal node
+ * @param budget Work allowed for the search, unlimited by default
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @param corridor Node IDs which may be expanded in place of the constrained node set of the graph, so searches on
+ * several threads can share the graph, none by default
+ * @return Results of search, a partial path toward the goal if the budget ran out
+ */
+SearchOutput a_star_nodes(const FlatGraph &graph, std::size_t start_id, std::size_t goal_id,
+                          const SearchBudget &budget = {}, SearchContext &context = get_thread_search_context(),
+                          const std::unordered_set<std::size_t> *corridor = nullptr);
+
+/**
+ * Perform A* search from any of several nodes of a layer to whichever of several others is reached first
+ * @note With several goal nodes the heuristic is the octile distance to the bounding box of their positions
+ * @param graph The graph to search over
+ * @param start_ids IDs of the start nodes
+ * @param goal_ids IDs of the goal nodes
+ * @param budget Work allowed for the search, unlimited by default
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search, the path leads from one of the start nodes to the goal node reached. A partial path
+ * toward the goals if the budget ran out.
+ */
+SearchOutput a_star_nodes(const FlatGraph &graph, const std::vector<std::size_t> &start_ids,
+                          const std::vector<std::size_t> &goal_ids, const SearchBudget &budget = {},
+                          SearchContext &context = get_thread_search_context());
+
+/**
+ * Start A* search on the layer 0 grid which can be run in slices, see AStarSearch
+ * @param graph The layer 0 grid graph to search over, must outlive the search
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace held by the search until it is done
+ * @return The search, with nothing expanded yet
+ */
+GridAStarSearch make_grid_a_star_search(const FlatGraph &graph, const GridPosition &start_pos,
+                                        const GridPosition &goal_pos,
+                                        SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform A* search on the layer 0 grid guided by the ALT heuristic
+ * @param graph The layer 0 grid graph to search over
+ * @param landmarks Landmark table built from the same graph
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search
+ */
+SearchOutput a_star(const FlatGraph &graph, const LandmarkTable &landmarks, const GridPosition &start_pos,
+                    const GridPosition &goal_pos, SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform A* search on the layer 0 grid guided by abstract layer distances (HA*)
+ * @note The abstract distances are searched with the backward workspace of the context
+ * @param graph The layer 0 grid graph to search over
+ * @param abstraction Abstract layer built from the same graph
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
  * @return Results of search
  */
-SearchOutput a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos);
+SearchOutput a_star(const FlatGraph &graph, const HomomorphicAbstraction &abstraction, const GridPosition &start_pos,
+                    const GridPosition &goal_pos, SearchContext &context = get_thread_search_context());
 
 }    // namespace tpl_search
 
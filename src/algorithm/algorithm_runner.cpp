@@ -6,11 +6,23 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
 
 #include "algorithm/a_star/a_star.h"
+#include "algorithm/ara_star/ara_star.h"
+#include "algorithm/bidir_a_star/bidir_a_star.h"
+#include "algorithm/common/abstraction_heuristic.h"
 #include "algorithm/common/graph_generator.h"
+#include "algorithm/common/landmarks.h"
+#include "algorithm/fringe/fringe.h"
+#include "algorithm/hda_star/hda_star.h"
+#include "algorithm/jps/jps.h"
+#include "algorithm/pra_star/abstract_path_cache.h"
+#include "algorithm/pra_star/k_controller.h"
 #include "algorithm/pra_star/pra_star.h"
+#include "algorithm/sma_star/sma_star.h"
 #include "algorithm_types.h"
+#include "util/bit_grid.h"
 #include "util/file_util.h"
 #include "util/map.h"
 #include "util/scenario.h"
@@ -19,14 +31,45 @@ namespace tpl_search {
 
 const std::string HEADER =
     "start_x,start_y,goal_x,goal_y,optimal_cost,solution_cost,expanded,generated,duration,first_move_duration";
+const std::string MEMORY_BOUNDED_HEADER = HEADER + ",peak_nodes";
+const std::string IMPROVEMENTS_HEADER =
+    "start_x,start_y,goal_x,goal_y,optimal_cost,solution_cost,suboptimality_bound,expanded,duration";
+const std::string LEVEL_SEARCHES_HEADER =
+    "start_x,start_y,goal_x,goal_y,iteration,level,expanded,generated,duration,corridor_size,cache_hit,reused";
+
+/**
+ * Start a level searches export, shared by the PRA* runners so the schema stays the same
+ * @param level_searches_file File to write the header to
+ */
+void write_level_searches_header(std::ofstream &level_searches_file) {
+    level_searches_file << LEVEL_SEARCHES_HEADER << std::endl;
+}
+
+/**
+ * Export the level searches of a scenario, written without flushing as there are several rows per scenario
+ * @param level_searches_file File to write the rows to
+ * @param scenario The scenario searched
+ * @param output Results of the search
+ */
+void write_level_searches(std::ofstream &level_searches_file, const Scenario &scenario, const SearchOutput &output) {
+    for (const auto &level_search : output.level_searches) {
+        level_searches_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << ","
+                            << scenario.goal_y << "," << level_search.iteration << "," << level_search.level << ","
+                            << level_search.expanded << "," << level_search.generated << "," << level_search.duration
+                            << "," << level_search.corridor_size << "," << level_search.is_cache_hit << ","
+                            << level_search.is_reused << "\n";
+    }
+}
 
 void algorithm_runner_astar(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
-                            std::ofstream &export_file) {
+                            OpenListType open_list_type, std::ofstream &export_file) {
     FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    SearchContext context;
     export_file << HEADER << std::endl;
 
     for (const auto &scenario : scenarios) {
-        SearchOutput output = a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y});
+        SearchOutput output = a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y},
+                                     context, open_list_type);
         std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
                   << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
                   << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
@@ -38,14 +81,187 @@ void algorithm_runner_astar(const std::string &scenario_path, const std::vector<
     }
 }
 
-void algorithm_runner_pra(const std::string &scenario_path, const std::vector<Scenario> &scenarios, std::size_t k,
+void algorithm_runner_astar_alt(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                                std::ofstream &export_file) {
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    LandmarkTable landmarks = load_landmarks(scenario_to_map_path(scenario_path), graph);
+    SearchContext context;
+    export_file << HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output = a_star(graph, landmarks, {scenario.start_x, scenario.start_y},
+                                     {scenario.goal_x, scenario.goal_y}, context);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+    }
+}
+
+void algorithm_runner_bidir_astar(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                                  std::ofstream &export_file) {
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    SearchContext context;
+    export_file << HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output =
+            bidir_a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+    }
+}
+
+void algorithm_runner_ara(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                          std::ofstream &export_file, std::ofstream &improvements_file) {
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    SearchContext context;
+    export_file << HEADER << std::endl;
+    improvements_file << IMPROVEMENTS_HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output =
+            ara_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, {}, context);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration
+                  << ", Improvements: " << output.improvements.size() << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+        for (const auto &improvement : output.improvements) {
+            improvements_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << ","
+                              << scenario.goal_y << "," << scenario.optimal_cost << "," << improvement.path_cost << ","
+                              << improvement.suboptimality_bound << "," << improvement.expanded << ","
+                              << improvement.duration << std::endl;
+        }
+    }
+}
+
+void algorithm_runner_hda(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                          std::size_t num_threads, std::ofstream &export_file) {
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    std::vector<SearchContext> contexts(num_threads);
+    export_file << HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output = hda_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y},
+                                       num_threads, contexts);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+    }
+}
+
+void algorithm_runner_fringe(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                             std::ofstream &export_file) {
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    SearchContext context;
+    export_file << HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output =
+            fringe(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+    }
+}
+
+void algorithm_runner_sma(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                          std::size_t max_nodes, std::ofstream &export_file) {
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    export_file << MEMORY_BOUNDED_HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output =
+            sma_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, max_nodes);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration
+                  << ", Peak nodes: " << output.peak_nodes << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << ","
+                    << output.peak_nodes << std::endl;
+    }
+}
+
+void algorithm_runner_jps(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
                           std::ofstream &export_file) {
-    HierarchicalGraph graph = load_hierarchical_graph(scenario_to_map_path(scenario_path));
+    BitGrid grid(load_map(scenario_to_map_path(scenario_path)));
+    SearchContext context;
     export_file << HEADER << std::endl;
 
     for (const auto &scenario : scenarios) {
         SearchOutput output =
-            pra_star(graph, k, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y});
+            jps(grid, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+    }
+}
+
+void algorithm_runner_jps_plus(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                               std::ofstream &export_file) {
+    BitGrid grid(load_map(scenario_to_map_path(scenario_path)));
+    JumpTable jump_table = load_jump_table(scenario_to_map_path(scenario_path));
+    SearchContext context;
+    export_file << HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output = jps_plus(grid, jump_table, {scenario.start_x, scenario.start_y},
+                                       {scenario.goal_x, scenario.goal_y}, context);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+    }
+}
+
+void algorithm_runner_ha(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                         std::ofstream &export_file) {
+    HierarchicalGraph graph = load_hierarchical_graph(scenario_to_map_path(scenario_path));
+    HomomorphicAbstraction abstraction(graph);
+    SearchContext context;
+    export_file << HEADER << std::endl;
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output = a_star(graph.get_layer(0), abstraction, {scenario.start_x, scenario.start_y},
+                                     {scenario.goal_x, scenario.goal_y}, context);
         std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
                   << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
                   << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
@@ -57,8 +273,74 @@ void algorithm_runner_pra(const std::string &scenario_path, const std::vector<Sc
     }
 }
 
+void algorithm_runner_pra(const std::string &scenario_path, const std::vector<Scenario> &scenarios, std::size_t k,
+                          std::size_t path_cache_size, const SearchBudget &k_target, std::ofstream &export_file,
+                          std::ofstream &level_searches_file) {
+    HierarchicalGraph graph = load_hierarchical_graph(scenario_to_map_path(scenario_path));
+    SearchContext context;
+    AbstractPathCache path_cache(path_cache_size);
+    AbstractPathCache *path_cache_ptr = path_cache_size > 0 ? &path_cache : nullptr;
+    // K is learned over the whole run, starting from the one given
+    std::optional<KController> k_controller;
+    if (k_target.is_limited()) {
+        k_controller.emplace(k_target, k > 0 ? k : KController::DEFAULT_INITIAL_K);
+    }
+    KController *k_controller_ptr = k_controller ? &*k_controller : nullptr;
+    export_file << HEADER << std::endl;
+    write_level_searches_header(level_searches_file);
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output = pra_star(graph, k, {scenario.start_x, scenario.start_y},
+                                       {scenario.goal_x, scenario.goal_y}, context, {}, path_cache_ptr,
+                                       k_controller_ptr);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+        write_level_searches(level_searches_file, scenario, output);
+    }
+    if (path_cache_ptr != nullptr) {
+        std::cout << "Path cache hits: " << path_cache.get_hits() << ", misses: " << path_cache.get_misses()
+                  << std::endl;
+    }
+    if (k_controller_ptr != nullptr) {
+        std::cout << "Dynamic K of first iterations from level 1: " << k_controller->get_k(true, 1)
+                  << ", later iterations from level 1: " << k_controller->get_k(false, 1) << std::endl;
+    }
+}
+
+void algorithm_runner_pra_parallel(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
+                                   std::size_t num_threads, std::ofstream &export_file,
+                                   std::ofstream &level_searches_file) {
+    HierarchicalGraph graph = load_hierarchical_graph(scenario_to_map_path(scenario_path));
+    std::vector<SearchContext> contexts(num_threads);
+    export_file << HEADER << std::endl;
+    write_level_searches_header(level_searches_file);
+
+    for (const auto &scenario : scenarios) {
+        SearchOutput output = pra_star_parallel(graph, {scenario.start_x, scenario.start_y},
+                                                {scenario.goal_x, scenario.goal_y}, num_threads, contexts);
+        std::cout << "Solution from (" << scenario.start_x << "," << scenario.start_y << "), to (" << scenario.goal_x
+                  << "," << scenario.goal_y << "). Optimal cost: " << scenario.optimal_cost
+                  << ", Found cost: " << output.path_cost << ", Expanded: " << output.expanded
+                  << ", Generated: " << output.generated << ", Total duration: " << output.duration
+                  << ", First move duration: " << output.first_move_duration << std::endl;
+        export_file << scenario.start_x << "," << scenario.start_y << "," << scenario.goal_x << "," << scenario.goal_y
+                    << "," << scenario.optimal_cost << "," << output.path_cost << "," << output.expanded << ","
+                    << output.generated << "," << output.duration << "," << output.first_move_duration << std::endl;
+        // The window of each search is given as its iteration
+        write_level_searches(level_searches_file, scenario, output);
+    }
+}
+
 void algorithm_runner(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
-                      const std::string &algorithm_str, std::size_t k, const std::string export_path) {
+                      const std::string &algorithm_str, std::size_t k, const std::string export_path,
+                      std::size_t num_threads, std::size_t max_nodes, std::size_t path_cache_size,
+                      const SearchBudget &k_target) {
     // Ensure algorithm is known
     if (ALGORITHM_STR_MAP.find(algorithm_str) == ALGORITHM_STR_MAP.end()) {
         std::cerr << "Error: Unknown algorithm type." << std::endl;
@@ -76,11 +358,67 @@ void algorithm_runner(const std::string &scenario_path, const std::vector<Scenar
 
     switch (algorithm) {
         case AlgorithmType::AStar: {
-            algorithm_runner_astar(scenario_path, scenarios, export_file);
+            algorithm_runner_astar(scenario_path, scenarios, OpenListType::PrioritySet, export_file);
+            break;
+        }
+        case AlgorithmType::AStarBucket: {
+            algorithm_runner_astar(scenario_path, scenarios, OpenListType::BucketQueue, export_file);
+            break;
+        }
+        case AlgorithmType::AStarALT: {
+            algorithm_runner_astar_alt(scenario_path, scenarios, export_file);
+            break;
+        }
+        case AlgorithmType::BidirAStar: {
+            algorithm_runner_bidir_astar(scenario_path, scenarios, export_file);
+            break;
+        }
+        case AlgorithmType::ARAStar: {
+            // Each solution found over time is saved next to the results
+            std::filesystem::path improvements_path(export_path);
+            improvements_path.replace_filename(improvements_path.stem().string() + "_improvements.csv");
+            std::ofstream improvements_file(improvements_path, std::ofstream::trunc | std::ofstream::out);
+            algorithm_runner_ara(scenario_path, scenarios, export_file, improvements_file);
+            break;
+        }
+        case AlgorithmType::HDAStar: {
+            algorithm_runner_hda(scenario_path, scenarios, num_threads, export_file);
+            break;
+        }
+        case AlgorithmType::HAStar: {
+            algorithm_runner_ha(scenario_path, scenarios, export_file);
+            break;
+        }
+        case AlgorithmType::Fringe: {
+            algorithm_runner_fringe(scenario_path, scenarios, export_file);
+            break;
+        }
+        case AlgorithmType::SMAStar: {
+            algorithm_runner_sma(scenario_path, scenarios, max_nodes, export_file);
+            break;
+        }
+        case AlgorithmType::JPS: {
+            algorithm_runner_jps(scenario_path, scenarios, export_file);
+            break;
+        }
+        case AlgorithmType::JPSPlus: {
+            algorithm_runner_jps_plus(scenario_path, scenarios, export_file);
             break;
         }
         case AlgorithmType::PRAStar: {
-            algorithm_runner_pra(scenario_path, scenarios, k, export_file);
+            // The search of each level is saved next to the results
+            std::filesystem::path level_searches_path(export_path);
+            level_searches_path.replace_filename(level_searches_path.stem().string() + "_levels.csv");
+            std::ofstream level_searches_file(level_searches_path, std::ofstream::trunc | std::ofstream::out);
+            algorithm_runner_pra(scenario_path, scenarios, k, path_cache_size, k_target, export_file,
+                                 level_searches_file);
+            break;
+        }
+        case AlgorithmType::PRAStarParallel: {
+            std::filesystem::path level_searches_path(export_path);
+            level_searches_path.replace_filename(level_searches_path.stem().string() + "_levels.csv");
+            std::ofstream level_searches_file(level_searches_path, std::ofstream::trunc | std::ofstream::out);
+            algorithm_runner_pra_parallel(scenario_path, scenarios, num_threads, export_file, level_searches_file);
             break;
         }
         default:
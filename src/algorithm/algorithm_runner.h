@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+#include "algorithm/common/search_budget.h"
 #include "util/scenario.h"
 
 namespace tpl_search {
@@ -18,9 +19,16 @@ namespace tpl_search {
  * @param algorithm_str String algorithm name
  * @param k K parameter for PRA* truncation
  * @param export_path Path to save search results
+ * @param num_threads Number of threads for parallel search algorithms
+ * @param max_nodes Most search nodes held at once by memory-bounded search algorithms, 0 for no limit
+ * @param path_cache_size Abstract paths cached across PRA* queries, 0 to disable the cache
+ * @param k_target Work each PRA* iteration should fit in, K is then picked per iteration in place of k. Unlimited
+ * by default, keeping K fixed.
  */
 void algorithm_runner(const std::string &scenario_path, const std::vector<Scenario> &scenarios,
-                      const std::string &algorithm_str, std::size_t k, const std::string export_path);
+                      const std::string &algorithm_str, std::size_t k, const std::string export_path,
+                      std::size_t num_threads = 1, std::size_t max_nodes = 0, std::size_t path_cache_size = 0,
+                      const SearchBudget &k_target = {});
 
 }    // namespace tpl_search
 
@@ -9,11 +9,36 @@
 
 namespace tpl_search {
 
-enum class AlgorithmType { AStar, PRAStar };
+enum class AlgorithmType {
+    AStar,
+    AStarBucket,
+    AStarALT,
+    BidirAStar,
+    ARAStar,
+    HDAStar,
+    HAStar,
+    Fringe,
+    SMAStar,
+    JPS,
+    JPSPlus,
+    PRAStar,
+    PRAStarParallel
+};
 
 const std::unordered_map<std::string, AlgorithmType> ALGORITHM_STR_MAP{
     {"astar", AlgorithmType::AStar},
+    {"astar_bucket", AlgorithmType::AStarBucket},
+    {"astar_alt", AlgorithmType::AStarALT},
+    {"bidir_astar", AlgorithmType::BidirAStar},
+    {"ara", AlgorithmType::ARAStar},
+    {"hda", AlgorithmType::HDAStar},
+    {"ha", AlgorithmType::HAStar},
+    {"fringe", AlgorithmType::Fringe},
+    {"sma", AlgorithmType::SMAStar},
+    {"jps", AlgorithmType::JPS},
+    {"jps_plus", AlgorithmType::JPSPlus},
     {"pra", AlgorithmType::PRAStar},
+    {"pra_parallel", AlgorithmType::PRAStarParallel},
 };
 
 }    // namespace tpl_search
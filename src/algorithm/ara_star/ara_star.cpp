@@ -0,0 +1,202 @@
+// File: ara_star.cpp
+// Anytime repairing A* (ARA*) search algorithm
+
+#include "ara_star.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+#include "util/timer.h"
+
+namespace tpl_search {
+
+namespace {
+
+// Expansions between checks of the time limit
+constexpr std::size_t TIMEOUT_CHECK_INTERVAL = 1024;
+
+template <typename GraphT, typename CostT>
+std::vector<std::size_t> reconstruct_path(const GraphT &graph, const SearchWorkspace<CostT> &workspace,
+                                          std::size_t current_index) {
+    assert(current_index != NO_PARENT);
+    std::vector<std::size_t> path;
+    while (current_index != NO_PARENT) {
+        path.push_back(graph.get_node_id(current_index));
+        current_index = workspace.get_parent(current_index);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+}    // namespace
+
+template <typename GraphT, typename HeuristicT, typename CostT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput ara_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                             const HeuristicT &heuristic, const ARAStarOptions &options, SearchContext &context) {
+    // Weighted keys are not representable in exact costs, so the open list is keyed on doubles while the g-values
+    // and the reported path costs stay exact
+    using Node = SearchNode<double>;
+    SearchWorkspace<CostT> &workspace = context.get_workspace<CostT>();
+    workspace.reset(graph.num_nodes());
+    HeapOpenList<double> open;
+    std::vector<std::size_t> closed_list;    // Nodes closed by the current search
+    std::vector<std::size_t> incons_list;    // Closed nodes whose g-value improved, may hold duplicates
+    std::vector<std::size_t> next_open;      // Nodes to key for the next search
+
+    // Init
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+    SearchOutput search_output;
+
+    ThreadTimer timer(options.time_limit);
+    timer.start();
+    bool timeout = false;
+
+    double weight = std::max(options.initial_weight, 1.0);
+    auto make_node = [&](std::size_t index) -> Node {
+        const double g = cost_to_double(workspace.get_g(index));
+        return {index, g, g + weight * cost_to_double(heuristic(index))};
+    };
+
+    // Expand until the goal is no worse than the weighted key of every open node
+    auto improve_path = [&]() {
+        while (!open.empty()) {
+            if (workspace.is_generated(goal_index) &&
+                !(cost_to_double(workspace.get_g(goal_index)) > open.top().f)) {
+                return;
+            }
+            if (expanded % TIMEOUT_CHECK_INTERVAL == 0 && timer.is_timeout()) {
+                timeout = true;
+                return;
+            }
+            const Node current = open.pop();
+            workspace.close(current.index);
+            closed_list.push_back(current.index);
+            ++expanded;
+
+            const CostT current_g = workspace.get_g(current.index);
+            graph.for_each_neighbour(current.index, [&](std::size_t child_index, const CostT &edge_cost) {
+                const CostT child_g = current_g + edge_cost;
+                if (workspace.is_generated(child_index) && !(child_g < workspace.get_g(child_index))) {
+                    return;
+                }
+                const bool was_closed = workspace.is_closed(child_index);
+                workspace.generate(child_index, child_g, current.index);
+                ++generated;
+                // Closed nodes stay closed until the next search, which picks them up from the incons list.
+                // Nodes closed by an earlier search are neither open nor closed, so are pushed again.
+                if (was_closed) {
+                    workspace.close(child_index);
+                    incons_list.push_back(child_index);
+                } else if (open.contains(child_index)) {
+                    open.decrease(make_node(child_index));
+                } else {
+                    open.push(make_node(child_index));
+                }
+            });
+        }
+    };
+
+    workspace.generate(start_index, CostT{}, NO_PARENT);
+    open.push(make_node(start_index));
+    while (true) {
+        improve_path();
+        if (!workspace.is_generated(goal_index)) {
+            // Timed out before the first path, or no path exists
+            break;
+        }
+
+        // Open and inconsistent nodes make up the next search, and bound the optimal cost from below
+        next_open.clear();
+        while (!open.empty()) {
+            next_open.push_back(open.pop().index);
+        }
+        for (const std::size_t index : incons_list) {
+            if (workspace.is_closed(index)) {
+                workspace.reopen(index);
+                next_open.push_back(index);
+            }
+        }
+        for (const std::size_t index : closed_list) {
+            workspace.reopen(index);
+        }
+        closed_list.clear();
+        incons_list.clear();
+
+        double lower_bound = std::numeric_limits<double>::infinity();
+        for (const std::size_t index : next_open) {
+            lower_bound = std::min(lower_bound, cost_to_double(workspace.get_g(index) + heuristic(index)));
+        }
+        const double path_cost = cost_to_double(workspace.get_g(goal_index));
+        // The weight only bounds the path once the search has finished
+        const double bound =
+            std::max(1.0, timeout ? path_cost / lower_bound : std::min(weight, path_cost / lower_bound));
+        const bool improved = search_output.improvements.empty() || path_cost < search_output.path_cost;
+        if (improved || bound < search_output.improvements.back().suboptimality_bound) {
+            const double duration = timer.get_duration();
+            if (search_output.improvements.empty()) {
+                search_output.first_move_duration = duration;
+            }
+            if (improved) {
+                search_output.path_cost = path_cost;
+                search_output.path_node_ids = reconstruct_path(graph, workspace, goal_index);
+            }
+            search_output.improvements.push_back({path_cost, bound, duration, expanded});
+#ifdef DEBUG
+            std::cout << "Solution improved. Weight: " << weight << ", solution cost: " << path_cost
+                      << ", bound: " << bound << ", Expanded: " << expanded << ", Time: " << duration << "s"
+                      << std::endl;
+#endif
+        }
+        // Stop once optimal, or when the weight can not be lowered further
+        const double next_weight = std::max(1.0, weight - options.weight_step);
+        if (timeout || bound <= 1 || !(next_weight < weight)) {
+            break;
+        }
+
+        // Lower the weight and key the nodes for the next search
+        weight = next_weight;
+        for (const std::size_t index : next_open) {
+            open.push(make_node(index));
+        }
+    }
+
+    search_output.expanded = expanded;
+    search_output.generated = generated;
+    search_output.duration = timer.get_duration();
+    if (search_output.improvements.empty()) {
+#ifdef DEBUG
+        std::cerr << "No solution found" << std::endl;
+#endif
+        search_output.first_move_duration = -1;
+        search_output.path_cost = -1;
+    }
+    return search_output;
+}
+
+template SearchOutput ara_star_search<GridGraphView, GridOctileHeuristic, OctileCost>(
+    const GridGraphView &, std::size_t, std::size_t, const GridOctileHeuristic &, const ARAStarOptions &,
+    SearchContext &);
+template SearchOutput ara_star_search<AbstractGraphView, AbstractOctileHeuristic, double>(
+    const AbstractGraphView &, std::size_t, std::size_t, const AbstractOctileHeuristic &, const ARAStarOptions &,
+    SearchContext &);
+
+SearchOutput ara_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                      const ARAStarOptions &options, SearchContext &context) {
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        return ara_star_search(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), options,
+                               context);
+    }
+    const AbstractGraphView view(graph);
+    return ara_star_search(view, start_index, goal_index, AbstractOctileHeuristic(view, goal_index), options,
+                           context);
+}
+
+}    // namespace tpl_search
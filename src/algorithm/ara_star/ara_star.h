@@ -0,0 +1,55 @@
+// File: ara_star.h
+// Anytime repairing A* (ARA*) search algorithm
+
+#ifndef PRA_ALGORITHM_ARA_STAR_H
+#define PRA_ALGORITHM_ARA_STAR_H
+
+#include "algorithm/common/graph.h"
+#include "algorithm/common/graph_view.h"
+#include "algorithm/common/search_concepts.h"
+#include "algorithm/common/search_context.h"
+#include "algorithm/common/search_output.h"
+
+namespace tpl_search {
+
+// Weight schedule and budget for ARA*
+struct ARAStarOptions {
+    double initial_weight = 3.0;    // Heuristic weight of the first search
+    double weight_step = 0.5;       // Amount the weight is lowered after each search down to 1, 0 for one search
+    double time_limit = 0;          // Seconds after which the best path so far is returned, 0 for no limit
+};
+
+/**
+ * Perform ARA* search over dense node indices.
+ * A weighted A* path is found first, then the weight is lowered and the search repaired, reusing the open list
+ * and the inconsistent nodes of the previous search, until the path is proven optimal or time runs out.
+ * @note Only the grid and abstract graph views with their octile heuristics are instantiated in ara_star.cpp
+ * @param graph The graph to search over
+ * @param start_index Dense index of the start node
+ * @param goal_index Dense index of the goal node
+ * @param heuristic Heuristic estimating the cost to the goal node, must be consistent
+ * @param options Weight schedule and time limit
+ * @param context Search workspace to reuse
+ * @return Results of search with the best path found, each improvement is given with its suboptimality bound
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput ara_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                             const HeuristicT &heuristic, const ARAStarOptions &options,
+                             SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform ARA* search
+ * @param graph The graph to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param options Weight schedule and time limit
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search
+ */
+SearchOutput ara_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                      const ARAStarOptions &options = {}, SearchContext &context = get_thread_search_context());
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_ARA_STAR_H
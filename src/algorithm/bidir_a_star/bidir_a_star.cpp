@@ -0,0 +1,173 @@
+// File: bidir_a_star.cpp
+// Bidirectional meet in the middle A* search algorithm
+
+#include "bidir_a_star.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include "util/timer.h"
+
+namespace tpl_search {
+
+namespace {
+
+// Search state of one direction
+template <typename CostT, typename HeuristicT>
+struct Frontier {
+    SearchWorkspace<CostT> &workspace;
+    HeapOpenList<CostT> &open;
+    const HeuristicT &heuristic;
+};
+
+// MM priority, which keeps either direction from expanding past the midpoint of the optimal path
+template <typename CostT>
+CostT priority(const CostT &g, const CostT &f) {
+    return std::max(f, g + g);
+}
+
+}    // namespace
+
+template <typename GraphT, typename HeuristicT, typename CostT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput bidir_a_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                                 const HeuristicT &forward_heuristic, const HeuristicT &backward_heuristic,
+                                 SearchContext &context) {
+    using Node = SearchNode<CostT>;
+    using FrontierT = Frontier<CostT, HeuristicT>;
+    SearchWorkspace<CostT> &forward_workspace = context.get_workspace<CostT>(SearchDirection::Forward);
+    SearchWorkspace<CostT> &backward_workspace = context.get_workspace<CostT>(SearchDirection::Backward);
+    forward_workspace.reset(graph.num_nodes());
+    backward_workspace.reset(graph.num_nodes());
+    FrontierT frontiers[2] = {
+        {forward_workspace, forward_workspace.template get_open<HeapOpenList<CostT>>(), forward_heuristic},
+        {backward_workspace, backward_workspace.template get_open<HeapOpenList<CostT>>(), backward_heuristic}};
+
+    // Init
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+
+    ThreadTimer timer;
+    timer.start();
+
+    // Cost of the best path found so far and the node where both searches meet on it
+    bool found = start_index == goal_index;
+    CostT best_cost{};
+    std::size_t meet_index = start_index;
+
+    forward_workspace.generate(start_index, CostT{}, NO_PARENT);
+    frontiers[0].open.push({start_index, CostT{}, priority(CostT{}, forward_heuristic(start_index))});
+    backward_workspace.generate(goal_index, CostT{}, NO_PARENT);
+    frontiers[1].open.push({goal_index, CostT{}, priority(CostT{}, backward_heuristic(goal_index))});
+
+    while (!frontiers[0].open.empty() && !frontiers[1].open.empty()) {
+        // Stop once the best path costs no more than the smallest priority of one direction, max(prminF, prminB),
+        // as no path through the open nodes can improve on it
+        const CostT forward_min = frontiers[0].open.top().f;
+        const CostT backward_min = frontiers[1].open.top().f;
+        if (found && (!(forward_min < best_cost) || !(backward_min < best_cost))) {
+            break;
+        }
+
+        // Expand the direction with the smaller priority, forward on ties
+        const std::size_t direction = backward_min < forward_min ? 1 : 0;
+        FrontierT &frontier = frontiers[direction];
+        const FrontierT &other = frontiers[1 - direction];
+        const Node current = frontier.open.pop();
+        frontier.workspace.close(current.index);
+        ++expanded;
+
+        graph.for_each_neighbour(current.index, [&](std::size_t child_index, const CostT &edge_cost) {
+            const CostT child_g = current.g + edge_cost;
+            const bool is_generated = frontier.workspace.is_generated(child_index);
+            if (is_generated && !(child_g < frontier.workspace.get_g(child_index))) {
+                return;
+            }
+
+            // Meeting the other search gives a complete path
+            bool is_meet = false;
+            if (other.workspace.is_generated(child_index)) {
+                const CostT path_cost = child_g + other.workspace.get_g(child_index);
+                if (!found || path_cost < best_cost) {
+                    found = true;
+                    best_cost = path_cost;
+                    meet_index = child_index;
+                    is_meet = true;
+                }
+            }
+
+            // Paths through the child cost at least its f-cost, so it cannot improve on the best path found.
+            // The meeting node is always generated, as its parent is needed to stitch the path.
+            const CostT child_f = child_g + frontier.heuristic(child_index);
+            if (found && !is_meet && !(child_f < best_cost)) {
+                return;
+            }
+
+            // Closed nodes are reopened on a better path, as the priority order does not guarantee optimal g
+            const bool was_open = is_generated && !frontier.workspace.is_closed(child_index);
+            frontier.workspace.generate(child_index, child_g, current.index);
+            const Node child_node{child_index, child_g, priority(child_g, child_f)};
+            if (was_open) {
+                frontier.open.decrease(child_node);
+            } else {
+                frontier.open.push(child_node);
+            }
+            ++generated;
+        });
+    }
+
+    if (!found) {
+#ifdef DEBUG
+        std::cerr << "Exhausted search space, no solution found" << std::endl;
+#endif
+        return {expanded, generated, timer.get_duration(), -1, -1, {}, {}};
+    }
+
+    // Stitch the forward path to the meeting node with the backward path from it
+    std::vector<std::size_t> path;
+    for (std::size_t index = meet_index; index != NO_PARENT; index = forward_workspace.get_parent(index)) {
+        path.push_back(graph.get_node_id(index));
+    }
+    std::reverse(path.begin(), path.end());
+    if (meet_index != goal_index) {
+        for (std::size_t index = backward_workspace.get_parent(meet_index); index != NO_PARENT;
+             index = backward_workspace.get_parent(index)) {
+            path.push_back(graph.get_node_id(index));
+        }
+    }
+    assert(path.front() == graph.get_node_id(start_index) && path.back() == graph.get_node_id(goal_index));
+
+    double duration = timer.get_duration();
+    const SearchOutput search_output{expanded, generated, duration, duration, cost_to_double(best_cost), path, {}};
+#ifdef DEBUG
+    std::cout << "Solution found. Solution length: " << search_output.path_node_ids.size()
+              << ", solution cost: " << search_output.path_cost << ", Expanded: " << expanded
+              << ", Generated: " << generated << ", Time: " << duration << "s" << std::endl;
+#endif
+    return search_output;
+}
+
+template SearchOutput bidir_a_star_search<GridGraphView, GridOctileHeuristic, OctileCost>(
+    const GridGraphView &, std::size_t, std::size_t, const GridOctileHeuristic &, const GridOctileHeuristic &,
+    SearchContext &);
+template SearchOutput bidir_a_star_search<AbstractGraphView, AbstractOctileHeuristic, double>(
+    const AbstractGraphView &, std::size_t, std::size_t, const AbstractOctileHeuristic &,
+    const AbstractOctileHeuristic &, SearchContext &);
+
+SearchOutput bidir_a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                          SearchContext &context) {
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        return bidir_a_star_search(view, start_index, goal_index, GridOctileHeuristic(view, goal_index),
+                                   GridOctileHeuristic(view, start_index), context);
+    }
+    const AbstractGraphView view(graph);
+    return bidir_a_star_search(view, start_index, goal_index, AbstractOctileHeuristic(view, goal_index),
+                               AbstractOctileHeuristic(view, start_index), context);
+}
+
+}    // namespace tpl_search
@@ -0,0 +1,48 @@
+// File: bidir_a_star.h
+// Bidirectional meet in the middle A* search algorithm
+
+#ifndef PRA_ALGORITHM_BIDIR_A_STAR_H
+#define PRA_ALGORITHM_BIDIR_A_STAR_H
+
+#include "algorithm/common/graph.h"
+#include "algorithm/common/graph_view.h"
+#include "algorithm/common/search_concepts.h"
+#include "algorithm/common/search_context.h"
+#include "algorithm/common/search_output.h"
+
+namespace tpl_search {
+
+/**
+ * Perform bidirectional MM search over dense node indices.
+ * Both directions expand in order of priority max(g + h, 2g), and the search stops once the best meeting cost found
+ * is no larger than the smallest priority of one of the open lists, the larger of the two minimums.
+ * @note Edges are treated as undirected, so the constrained node set of the graph should be empty
+ * @note Only the grid and abstract graph views with their octile heuristics are instantiated in bidir_a_star.cpp
+ * @param graph The graph to search over
+ * @param start_index Dense index of the start node
+ * @param goal_index Dense index of the goal node
+ * @param forward_heuristic Heuristic estimating the cost to the goal node
+ * @param backward_heuristic Heuristic estimating the cost to the start node
+ * @param context Search workspace to reuse, both directional workspaces are used
+ * @return Results of search, the path is given as node IDs
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput bidir_a_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                                 const HeuristicT &forward_heuristic, const HeuristicT &backward_heuristic,
+                                 SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform bidirectional MM search
+ * @param graph The graph to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search
+ */
+SearchOutput bidir_a_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                          SearchContext &context = get_thread_search_context());
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_BIDIR_A_STAR_H
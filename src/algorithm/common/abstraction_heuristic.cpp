@@ -0,0 +1,85 @@
+// File: abstraction_heuristic.cpp
+// Abstract layer distances used as a heuristic on the layer 0 grid (HA*)
+
+#include "abstraction_heuristic.h"
+
+#include <cassert>
+#include <unordered_map>
+
+namespace tpl_search {
+
+HomomorphicAbstraction::HomomorphicAbstraction(HierarchicalGraph &graph, std::size_t level) {
+    assert(level >= 1 && level < graph.num_layers());
+    const FlatGraph &grid = graph.get_layer(0);
+    const FlatGraph &layer = graph.get_layer(level);
+    const GridGraphView view(grid);
+
+    // Map each grid cell to the abstract node representing it
+    abstract_indices.assign(grid.num_nodes(), 0);
+    const std::vector<GraphNode> &abstract_nodes = layer.get_all_nodes();
+    for (std::size_t abstract_index = 0; abstract_index < abstract_nodes.size(); ++abstract_index) {
+        for (const GridPosition &position : abstract_nodes[abstract_index].represented_positions) {
+            const std::size_t index = grid.get_node_index(grid.get_pos_node_id(position));
+            abstract_indices[index] = static_cast<std::uint32_t>(abstract_index);
+        }
+    }
+
+    // Cheapest grid step between each pair of neighbouring abstract nodes
+    std::vector<std::unordered_map<std::uint32_t, OctileCost>> edges(abstract_nodes.size());
+    for (std::size_t index = 0; index < grid.num_nodes(); ++index) {
+        const std::uint32_t abstract_index = abstract_indices[index];
+        view.for_each_neighbour(index, [&](std::size_t neighbour_index, const OctileCost &edge_cost) {
+            const std::uint32_t neighbour_abstract_index = abstract_indices[neighbour_index];
+            if (neighbour_abstract_index == abstract_index) {
+                return;
+            }
+            auto [edge, inserted] = edges[abstract_index].try_emplace(neighbour_abstract_index, edge_cost);
+            if (!inserted) {
+                edge->second = std::min(edge->second, edge_cost);
+            }
+        });
+    }
+
+    edge_offsets.reserve(abstract_nodes.size() + 1);
+    edge_offsets.push_back(0);
+    for (const auto &node_edges : edges) {
+        for (const auto &[target, cost] : node_edges) {
+            edge_targets.push_back(target);
+            edge_costs.push_back(cost);
+        }
+        edge_offsets.push_back(edge_targets.size());
+    }
+}
+
+AbstractionHeuristic::AbstractionHeuristic(const GridGraphView &graph, const HomomorphicAbstraction &abstraction,
+                                           std::size_t goal_index, SearchWorkspace<OctileCost> &workspace)
+    : octile(graph, goal_index),
+      abstraction(abstraction),
+      workspace(workspace),
+      open(workspace.get_open<HeapOpenList<OctileCost>>()) {
+    workspace.reset(abstraction.num_abstract_nodes());
+    const std::size_t goal_abstract_index = abstraction.get_abstract_index(goal_index);
+    workspace.generate(goal_abstract_index, OctileCost{}, NO_PARENT);
+    open.push({goal_abstract_index, OctileCost{}, OctileCost{}});
+}
+
+OctileCost AbstractionHeuristic::abstract_distance(std::size_t abstract_index) const {
+    // Abstract edges are symmetric, so the backward search runs over the same edges
+    while (!workspace.is_closed(abstract_index) && !open.empty()) {
+        const SearchNode<OctileCost> current = open.pop();
+        workspace.close(current.index);
+        abstraction.for_each_neighbour(current.index, [&](std::size_t neighbour_index, const OctileCost &edge_cost) {
+            const OctileCost neighbour_g = current.g + edge_cost;
+            if (!workspace.is_generated(neighbour_index)) {
+                workspace.generate(neighbour_index, neighbour_g, current.index);
+                open.push({neighbour_index, neighbour_g, neighbour_g});
+            } else if (!workspace.is_closed(neighbour_index) && neighbour_g < workspace.get_g(neighbour_index)) {
+                workspace.generate(neighbour_index, neighbour_g, current.index);
+                open.decrease({neighbour_index, neighbour_g, neighbour_g});
+            }
+        });
+    }
+    return workspace.is_closed(abstract_index) ? workspace.get_g(abstract_index) : OctileCost{};
+}
+
+}    // namespace tpl_search
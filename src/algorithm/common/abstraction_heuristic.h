@@ -0,0 +1,102 @@
+// File: abstraction_heuristic.h
+// Abstract layer distances used as a heuristic on the layer 0 grid (HA*)
+
+#ifndef PRA_ALGORITHM_COMMON_ABSTRACTION_HEURISTIC_H
+#define PRA_ALGORITHM_COMMON_ABSTRACTION_HEURISTIC_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "graph_view.h"
+#include "octile_cost.h"
+#include "search_context.h"
+
+namespace tpl_search {
+
+// An abstract layer of a hierarchical graph, weighted so that its distances bound the layer 0 grid distances.
+// Each abstract edge costs the cheapest grid step between the cells of its two nodes, and moving within a node is free,
+// so every grid path maps onto an abstract path which costs no more. Edges are derived from the layer 0 grid and held
+// by dense abstract node index.
+class HomomorphicAbstraction {
+public:
+    static constexpr std::size_t DEFAULT_LEVEL = 1;
+
+    HomomorphicAbstraction() = default;
+
+    /**
+     * Build the weighted abstract graph of a layer
+     * @param graph The hierarchical graph holding the layers
+     * @param level The abstract layer to use, at least 1
+     */
+    HomomorphicAbstraction(HierarchicalGraph &graph, std::size_t level = DEFAULT_LEVEL);
+
+    std::size_t num_abstract_nodes() const {
+        return edge_offsets.empty() ? 0 : edge_offsets.size() - 1;
+    }
+
+    /**
+     * Get the abstract node representing a grid node
+     * @param index Dense index of the layer 0 node
+     * @return Dense index of the abstract node
+     */
+    std::size_t get_abstract_index(std::size_t index) const {
+        return abstract_indices[index];
+    }
+
+    /**
+     * Visit each neighbour of an abstract node
+     * @param abstract_index Dense index of the abstract node
+     * @param visit Called with the dense index of the neighbour and the cost of the edge to it
+     */
+    template <typename VisitT>
+    void for_each_neighbour(std::size_t abstract_index, VisitT &&visit) const {
+        for (std::size_t i = edge_offsets[abstract_index]; i < edge_offsets[abstract_index + 1]; ++i) {
+            visit(edge_targets[i], edge_costs[i]);
+        }
+    }
+
+private:
+    std::vector<std::uint32_t> abstract_indices;    // Abstract node of each layer 0 node
+    std::vector<std::size_t> edge_offsets;          // Start of the edges of each abstract node, one past the last
+    std::vector<std::uint32_t> edge_targets;
+    std::vector<OctileCost> edge_costs;
+};
+
+// HA* heuristic, the larger of the octile distance and the abstract distance to the goal.
+// Abstract distances come from a backward Dijkstra search from the abstract node of the goal, which is resumed lazily
+// until the abstract node asked for is closed. The distances are cached in the given workspace for the whole query.
+class AbstractionHeuristic {
+public:
+    /**
+     * Start the abstract search for a query
+     * @param graph The layer 0 grid
+     * @param abstraction Abstract layer of the same grid
+     * @param goal_index Dense index of the goal node
+     * @param workspace Workspace for the abstract search, not to be used by the layer 0 search
+     */
+    AbstractionHeuristic(const GridGraphView &graph, const HomomorphicAbstraction &abstraction, std::size_t goal_index,
+                         SearchWorkspace<OctileCost> &workspace);
+
+    OctileCost operator()(std::size_t index) const {
+        return std::max(octile(index), abstract_distance(abstraction.get_abstract_index(index)));
+    }
+
+private:
+    /**
+     * Get the abstract distance to the goal, searching further if not yet known
+     * @param abstract_index Dense index of the abstract node
+     * @return Distance to the abstract node of the goal, zero if it can't be reached
+     */
+    OctileCost abstract_distance(std::size_t abstract_index) const;
+
+    GridOctileHeuristic octile;
+    const HomomorphicAbstraction &abstraction;
+    SearchWorkspace<OctileCost> &workspace;
+    HeapOpenList<OctileCost> &open;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_ABSTRACTION_HEURISTIC_H
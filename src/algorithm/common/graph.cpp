@@ -3,10 +3,13 @@
 
 #include "graph.h"
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <utility>
 
 #include "graph_util.h"
 
@@ -40,9 +43,60 @@ double distance(const GraphNode *n1, const GraphNode *n2) {
 
 // -------------------------- FlatGraph  --------------------------
 
+namespace {
+// Add a neighbour to an adjacency list kept in ascending order of dense index, so a graph built and the same graph
+// loaded visit neighbours in the same order and break ties alike
+void insert_neighbour_index(std::vector<std::size_t> &neighbour_indices, std::size_t neighbour_index) {
+    neighbour_indices.insert(std::lower_bound(neighbour_indices.begin(), neighbour_indices.end(), neighbour_index),
+                             neighbour_index);
+}
+
+// Node represents a single grid cell located at its own position
+bool is_grid_node(const GraphNode &node) {
+    if (node.represented_positions.size() != 1) {
+        return false;
+    }
+    const GridPosition &position = *node.represented_positions.begin();
+    return node.position.x == static_cast<double>(position.x) && node.position.y == static_cast<double>(position.y);
+}
+
+// Summarise the cells a node represents
+CellBounds compute_cell_bounds(const GraphNode &node) {
+    assert(!node.represented_positions.empty());
+    const GridPosition &first = *node.represented_positions.begin();
+    CellBounds bounds{first, first, first};
+    double best_distance = distance(node.position, first);
+    for (const auto &position : node.represented_positions) {
+        bounds.min_corner = {std::min(bounds.min_corner.x, position.x), std::min(bounds.min_corner.y, position.y)};
+        bounds.max_corner = {std::max(bounds.max_corner.x, position.x), std::max(bounds.max_corner.y, position.y)};
+        // Ties go to the smallest coordinates, so the pick doesn't depend on the set order
+        const double position_distance = distance(node.position, position);
+        if (position_distance < best_distance ||
+            (position_distance == best_distance &&
+             std::make_pair(position.y, position.x) <
+                 std::make_pair(bounds.representative.y, bounds.representative.x))) {
+            best_distance = position_distance;
+            bounds.representative = position;
+        }
+    }
+    return bounds;
+}
+
+// Longer side of a bounding box, less one
+std::size_t get_extent(const CellBounds &bounds) {
+    return std::max(bounds.max_corner.x - bounds.min_corner.x, bounds.max_corner.y - bounds.min_corner.y);
+}
+}    // namespace
+
 void FlatGraph::add_node(const GraphNode &node) {
+    grid_graph = grid_graph && is_grid_node(node);
     node_id_idx_map[node.id] = node_storage.size();
     neighbour_mapping[node.id].clear();
+    neighbour_indices.emplace_back();
+    move_masks.push_back(0);
+    move_targets.emplace_back();
+    cell_bounds.push_back(compute_cell_bounds(node));
+    max_cell_extent = std::max(max_cell_extent, get_extent(cell_bounds.back()));
     node_storage.push_back(node);
     for (const auto &position : node.represented_positions) {
         position_id_mapping[position] = node.id;
@@ -52,11 +106,29 @@ void FlatGraph::add_node(const GraphNode &node) {
 void FlatGraph::add_edge(std::size_t id1, std::size_t id2) {
     assert(node_id_idx_map.find(id1) != node_id_idx_map.end());
     assert(node_id_idx_map.find(id2) != node_id_idx_map.end());
-    neighbour_mapping[id1].insert(id2);
-    neighbour_mapping[id2].insert(id1);
+    if (neighbour_mapping[id1].insert(id2).second) {
+        insert_neighbour_index(neighbour_indices[node_id_idx_map.at(id1)], node_id_idx_map.at(id2));
+        add_move(node_id_idx_map.at(id1), node_id_idx_map.at(id2));
+    }
+    if (neighbour_mapping[id2].insert(id1).second) {
+        insert_neighbour_index(neighbour_indices[node_id_idx_map.at(id2)], node_id_idx_map.at(id1));
+        add_move(node_id_idx_map.at(id2), node_id_idx_map.at(id1));
+    }
     ++edge_counter;
 }
 
+void FlatGraph::add_move(std::size_t index, std::size_t neighbour_index) {
+    const double dx = node_storage[neighbour_index].position.x - node_storage[index].position.x;
+    const double dy = node_storage[neighbour_index].position.y - node_storage[index].position.y;
+    for (std::size_t move = 0; move < NUM_GRID_MOVES; ++move) {
+        if (dx == GRID_MOVE_DX[move] && dy == GRID_MOVE_DY[move]) {
+            move_masks[index] |= static_cast<std::uint8_t>(1 << move);
+            move_targets[index][move] = static_cast<std::uint32_t>(neighbour_index);
+            return;
+        }
+    }
+}
+
 std::size_t FlatGraph::get_edge_count() {
     return edge_counter;
 }
@@ -69,11 +141,23 @@ const GraphNode *FlatGraph::get_node(std::size_t id) const {
     return &node_storage.at(node_id_idx_map.at(id));
 }
 
+std::size_t FlatGraph::get_node_index(std::size_t id) const {
+    return node_id_idx_map.at(id);
+}
+
+std::size_t FlatGraph::num_nodes() const {
+    return node_storage.size();
+}
+
 std::size_t FlatGraph::get_pos_node_id(const GridPosition &position) const {
     assert(position_id_mapping.find(position) != position_id_mapping.end());
     return position_id_mapping.at(position);
 }
 
+bool FlatGraph::is_grid_graph() const {
+    return grid_graph;
+}
+
 const std::vector<GraphNode> &FlatGraph::get_all_nodes() const {
     return node_storage;
 }
@@ -172,13 +256,27 @@ void FlatGraph::load(nop::Deserializer<nop::StreamReader<std::ifstream>> &deseri
     // Necessary conversions due to libnop not supporting unordered_set
     node_storage.clear();
     node_storage.reserve(node_storage.size());
+    grid_graph = true;
+    cell_bounds.clear();
+    max_cell_extent = 0;
     for (const auto &node : nodes_serializable) {
         node_storage.emplace_back(GraphNode::from_serializable(node));
+        grid_graph = grid_graph && is_grid_node(node_storage.back());
+        cell_bounds.push_back(compute_cell_bounds(node_storage.back()));
+        max_cell_extent = std::max(max_cell_extent, get_extent(cell_bounds.back()));
     }
 
     neighbour_mapping.clear();
+    neighbour_indices.assign(node_storage.size(), {});
+    move_masks.assign(node_storage.size(), 0);
+    move_targets.assign(node_storage.size(), {});
     for (const auto &[node, neighbours] : neighbour_mapping_serializable) {
         neighbour_mapping[node] = std::unordered_set<std::size_t>(neighbours.begin(), neighbours.end());
+        const std::size_t index = node_id_idx_map.at(node);
+        for (const auto &neighbour : neighbour_mapping[node]) {
+            insert_neighbour_index(neighbour_indices[index], node_id_idx_map.at(neighbour));
+            add_move(index, node_id_idx_map.at(neighbour));
+        }
     }
 
     constrained_nodes.clear();
@@ -202,6 +300,7 @@ HierarchicalGraph::HierarchicalGraph(const FlatGraph &graph) {
                   << flat_graph_layers.back().get_all_node_ids().size() << " edges "
                   << flat_graph_layers.back().get_edge_count() << std::endl;
     }
+    index_parents();
 }
 
 std::size_t HierarchicalGraph::num_layers() const {
@@ -273,6 +372,22 @@ void HierarchicalGraph::load(const std::string &path) {
         }
         parent_child_mappings.emplace_back(std::move(map));
     }
+    index_parents();
+}
+
+void HierarchicalGraph::index_parents() {
+    parent_indices.assign(parent_child_mappings.size(), {});
+    for (std::size_t level = 0; level < parent_child_mappings.size(); ++level) {
+        const FlatGraph &graph = flat_graph_layers[level];
+        const FlatGraph &parent_graph = flat_graph_layers[level + 1];
+        parent_indices[level].assign(graph.num_nodes(), std::numeric_limits<std::size_t>::max());
+        for (const auto &[parent_id, child_ids] : parent_child_mappings[level]) {
+            const std::size_t parent_index = parent_graph.get_node_index(parent_id);
+            for (const std::size_t child_id : child_ids) {
+                parent_indices[level][graph.get_node_index(child_id)] = parent_index;
+            }
+        }
+    }
 }
 
 // -------------------------- HierarchicalGraph  --------------------------
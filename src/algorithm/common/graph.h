@@ -10,6 +10,9 @@
 #include <nop/utility/stream_reader.h>
 #include <nop/utility/stream_writer.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <unordered_map>
@@ -123,6 +126,40 @@ double distance(const AbstractPosition &p1, const GridPosition &p2);
  */
 double distance(const GraphNode *n1, const GraphNode *n2);
 
+// Cells represented by a node, summarised so sub-goals are picked without walking every cell
+struct CellBounds {
+    GridPosition representative;    // Represented cell closest to the node position
+    GridPosition min_corner;        // Smallest coordinates of the represented cells
+    GridPosition max_corner;        // Largest coordinates of the represented cells
+
+    /**
+     * Lower bound of the distance from any represented cell to a position, the distance to the bounding box
+     * @param position Grid position to measure to
+     * @return Lower bound of the distance, zero if the position lies within the bounding box
+     */
+    double lower_bound(const GridPosition &position) const {
+        return distance(GridPosition{std::clamp(position.x, min_corner.x, max_corner.x),
+                                     std::clamp(position.y, min_corner.y, max_corner.y)},
+                        position);
+    }
+};
+
+// Moves between neighbouring grid cells, cardinal moves first, in the order of the move mask bits
+enum GridMove {
+    MOVE_EAST,
+    MOVE_WEST,
+    MOVE_SOUTH,
+    MOVE_NORTH,
+    MOVE_SOUTH_EAST,
+    MOVE_SOUTH_WEST,
+    MOVE_NORTH_EAST,
+    MOVE_NORTH_WEST,
+    NUM_GRID_MOVES
+};
+constexpr std::size_t NUM_CARDINAL_MOVES = 4;
+constexpr std::array<int, NUM_GRID_MOVES> GRID_MOVE_DX{1, -1, 0, 0, 1, -1, 1, -1};
+constexpr std::array<int, NUM_GRID_MOVES> GRID_MOVE_DY{0, 0, 1, -1, 1, 1, -1, -1};
+
 // Flat graph used in search
 class FlatGraph {
 public:
@@ -161,6 +198,84 @@ public:
      */
     const GraphNode *get_node(std::size_t id) const;
 
+    /**
+     * Get the dense index of a node, which is in the range [0, num_nodes())
+     * @param id Node ID to query
+     * @return Index of the node in the graph storage
+     */
+    std::size_t get_node_index(std::size_t id) const;
+
+    /**
+     * Get the ID of a node from its dense index
+     * @param index Dense index of the node
+     * @return Node ID
+     */
+    std::size_t get_node_id(std::size_t index) const {
+        return node_storage[index].id;
+    }
+
+    /**
+     * Get the neighbours of a node as dense indices
+     * @note Unlike get_neighbours, the constrained node set is not applied, see is_expandable
+     * @param index Dense index of the node to query
+     * @return Dense indices of the neighbours in ascending order, the same whether the graph was built or loaded
+     */
+    const std::vector<std::size_t> &get_neighbour_indices(std::size_t index) const {
+        return neighbour_indices[index];
+    }
+
+    /**
+     * Get the moves leading to the neighbours of a node of a grid graph
+     * @note Only meaningful for grid graphs, the constrained node set is not applied
+     * @param index Dense index of the node to query
+     * @return Bit i is set if GridMove i leads to a neighbour
+     */
+    std::uint8_t get_move_mask(std::size_t index) const {
+        return move_masks[index];
+    }
+
+    /**
+     * Get the neighbours of a node of a grid graph by move
+     * @note Only meaningful for grid graphs, entries of moves missing from get_move_mask are zero
+     * @param index Dense index of the node to query
+     * @return Dense index of the neighbour reached by each GridMove
+     */
+    const std::array<std::uint32_t, NUM_GRID_MOVES> &get_move_targets(std::size_t index) const {
+        return move_targets[index];
+    }
+
+    /**
+     * Get the summary of the cells a node represents, computed as nodes are added or loaded
+     * @param index Dense index of the node to query
+     * @return Representative cell and bounding box of the node
+     */
+    const CellBounds &get_cell_bounds(std::size_t index) const {
+        return cell_bounds[index];
+    }
+
+    /**
+     * Get the largest bounding box side of any node, less one, so zero for a grid
+     * @return Largest number of steps along either axis between two cells of the same node
+     */
+    std::size_t get_max_cell_extent() const {
+        return max_cell_extent;
+    }
+
+    /**
+     * Check if a node may have its neighbours generated under the constrained node set
+     * @param index Dense index of the node to query
+     * @return True if there are no constrained nodes or the node is one of them, false otherwise
+     */
+    bool is_expandable(std::size_t index) const {
+        return constrained_nodes.empty() || constrained_nodes.find(node_storage[index].id) != constrained_nodes.end();
+    }
+
+    /**
+     * Get the number of nodes in the graph
+     * @return Number of nodes in the graph
+     */
+    std::size_t num_nodes() const;
+
     /**
      * Get the node ID a position is represented by
      * @param position The grid position to query
@@ -168,6 +283,13 @@ public:
      */
     std::size_t get_pos_node_id(const GridPosition &position) const;
 
+    /**
+     * Check if the graph is a grid graph, i.e. every node represents a single grid cell at its own position
+     * @note Grid graphs are searched using exact octile costs
+     * @return True if the graph is a grid graph, false otherwise
+     */
+    bool is_grid_graph() const;
+
     /**
      * Get all nodes in the graph
      * @return Vector of all nodes in the graph
@@ -234,12 +356,25 @@ public:
     void load(nop::Deserializer<nop::StreamReader<std::ifstream>> &deserializer);
 
 private:
+    /**
+     * Record the move from a node to a neighbouring grid cell
+     * @param index Dense index of the node
+     * @param neighbour_index Dense index of the neighbour, ignored unless one step away
+     */
+    void add_move(std::size_t index, std::size_t neighbour_index);
+
     std::vector<GraphNode> node_storage;
     std::unordered_map<std::size_t, std::size_t> node_id_idx_map;
     std::unordered_map<std::size_t, std::unordered_set<std::size_t>> neighbour_mapping;
+    std::vector<std::vector<std::size_t>> neighbour_indices;    // Sorted adjacency by dense index, as neighbour_mapping
+    std::vector<std::uint8_t> move_masks;                                   // Grid adjacency by move
+    std::vector<std::array<std::uint32_t, NUM_GRID_MOVES>> move_targets;    // Grid adjacency by move
+    std::vector<CellBounds> cell_bounds;                                    // Summary of the represented cells
+    std::size_t max_cell_extent = 0;
     std::unordered_map<GridPosition, std::size_t, PairHash> position_id_mapping;
     std::unordered_set<std::size_t> constrained_nodes;
     std::size_t edge_counter = 0;
+    bool grid_graph = true;
 };
 
 // Hierarchical graph composed of flat layer graphs
@@ -272,6 +407,16 @@ public:
      */
     const std::unordered_set<std::size_t> &get_parent_child_mapping(std::size_t level, std::size_t parent_node_id);
 
+    /**
+     * Get the parent of a node in the layer above
+     * @param level Level of the node, below the top level
+     * @param index Dense index of the node
+     * @return Dense index of the parent in layer level + 1
+     */
+    std::size_t get_parent_index(std::size_t level, std::size_t index) const {
+        return parent_indices[level][index];
+    }
+
     /**
      * Save the graph to the given path
      * @param path Path to serialize the graph
@@ -285,8 +430,12 @@ public:
     void load(const std::string &path);
 
 private:
+    // Fill parent_indices from the parent child mappings
+    void index_parents();
+
     std::vector<FlatGraph> flat_graph_layers;
     std::vector<ParentChildMap> parent_child_mappings;
+    std::vector<std::vector<std::size_t>> parent_indices;    // Dense parent index of each node by level, not saved
 };
 
 }    // namespace tpl_search
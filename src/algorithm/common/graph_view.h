@@ -0,0 +1,239 @@
+// File: graph_view.h
+// Views of flat graph layers and heuristics for the generic search algorithms
+
+#ifndef PRA_ALGORITHM_COMMON_GRAPH_VIEW_H
+#define PRA_ALGORITHM_COMMON_GRAPH_VIEW_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "graph.h"
+#include "octile_cost.h"
+
+namespace tpl_search {
+
+// Layer 0 grid graph, edges cost exactly one cardinal or diagonal step
+class GridGraphView {
+public:
+    using CostType = OctileCost;
+
+    /**
+     * @param graph The layer 0 grid graph
+     * @param corridor Node IDs which may be expanded, used in place of the constrained node set of the graph so
+     * searches with different corridors can share it, none by default
+     */
+    explicit GridGraphView(const FlatGraph &graph, const std::unordered_set<std::size_t> *corridor = nullptr)
+        : graph(graph), nodes(graph.get_all_nodes()), corridor(corridor) {
+        assert(graph.is_grid_graph());
+    }
+
+    std::size_t num_nodes() const {
+        return nodes.size();
+    }
+
+    std::size_t get_node_id(std::size_t index) const {
+        return nodes[index].id;
+    }
+
+    /**
+     * Get the grid cell of a node
+     * @param index Dense index of the node
+     * @return Grid position of the node
+     */
+    GridPosition get_position(std::size_t index) const {
+        const AbstractPosition &position = nodes[index].position;
+        return {static_cast<std::size_t>(position.x), static_cast<std::size_t>(position.y)};
+    }
+
+    /**
+     * Visit each neighbour of a node, respecting the corridor or the constrained node set of the graph
+     * @param index Dense index of the node
+     * @param visit Called with the dense index of the neighbour and the cost of the edge to it
+     */
+    template <typename VisitT>
+    void for_each_neighbour(std::size_t index, VisitT &&visit) const {
+        if (!is_expandable(index)) {
+            return;
+        }
+        const AbstractPosition &position = nodes[index].position;
+        for (const std::size_t neighbour_index : graph.get_neighbour_indices(index)) {
+            const AbstractPosition &neighbour_position = nodes[neighbour_index].position;
+            const bool diagonal = position.x != neighbour_position.x && position.y != neighbour_position.y;
+            visit(neighbour_index, diagonal ? DIAGONAL_STEP : CARDINAL_STEP);
+        }
+    }
+
+    /**
+     * Get the moves leading to the neighbours of a node, respecting the corridor or the constrained node set of the
+     * graph
+     * @param index Dense index of the node
+     * @return Bit i is set if GridMove i leads to a neighbour
+     */
+    std::uint8_t get_move_mask(std::size_t index) const {
+        return is_expandable(index) ? graph.get_move_mask(index) : 0;
+    }
+
+    /**
+     * Get the neighbours of a node by move
+     * @param index Dense index of the node
+     * @return Dense index of the neighbour reached by each GridMove, only valid for the moves in get_move_mask
+     */
+    const std::array<std::uint32_t, NUM_GRID_MOVES> &get_move_targets(std::size_t index) const {
+        return graph.get_move_targets(index);
+    }
+
+private:
+    bool is_expandable(std::size_t index) const {
+        return corridor == nullptr ? graph.is_expandable(index) : corridor->find(nodes[index].id) != corridor->end();
+    }
+
+    const FlatGraph &graph;
+    const std::vector<GraphNode> &nodes;
+    const std::unordered_set<std::size_t> *corridor;
+};
+
+// Abstract layer graph, edges cost the octile distance between the node positions
+class AbstractGraphView {
+public:
+    using CostType = double;
+
+    /**
+     * @param graph The abstract layer graph
+     * @param corridor Node IDs which may be expanded, used in place of the constrained node set of the graph, none by
+     * default
+     */
+    explicit AbstractGraphView(const FlatGraph &graph, const std::unordered_set<std::size_t> *corridor = nullptr)
+        : graph(graph), nodes(graph.get_all_nodes()), corridor(corridor) {}
+
+    std::size_t num_nodes() const {
+        return nodes.size();
+    }
+
+    std::size_t get_node_id(std::size_t index) const {
+        return nodes[index].id;
+    }
+
+    /**
+     * Get the position of a node
+     * @param index Dense index of the node
+     * @return Position of the node
+     */
+    const AbstractPosition &get_position(std::size_t index) const {
+        return nodes[index].position;
+    }
+
+    /**
+     * Visit each neighbour of a node, respecting the corridor or the constrained node set of the graph
+     * @param index Dense index of the node
+     * @param visit Called with the dense index of the neighbour and the cost of the edge to it
+     */
+    template <typename VisitT>
+    void for_each_neighbour(std::size_t index, VisitT &&visit) const {
+        if (!is_expandable(index)) {
+            return;
+        }
+        const AbstractPosition &position = nodes[index].position;
+        for (const std::size_t neighbour_index : graph.get_neighbour_indices(index)) {
+            visit(neighbour_index, distance(position, nodes[neighbour_index].position));
+        }
+    }
+
+private:
+    bool is_expandable(std::size_t index) const {
+        return corridor == nullptr ? graph.is_expandable(index) : corridor->find(nodes[index].id) != corridor->end();
+    }
+
+    const FlatGraph &graph;
+    const std::vector<GraphNode> &nodes;
+    const std::unordered_set<std::size_t> *corridor;
+};
+
+// Exact octile distance to the goal cell, holding its own copy of the view so it may outlive the one it was built from
+class GridOctileHeuristic {
+public:
+    GridOctileHeuristic(const GridGraphView &graph, std::size_t goal_index)
+        : graph(graph), goal_position(graph.get_position(goal_index)) {}
+
+    OctileCost operator()(std::size_t index) const {
+        return octile_distance(graph.get_position(index), goal_position);
+    }
+
+    const GridPosition &get_goal_position() const {
+        return goal_position;
+    }
+
+private:
+    GridGraphView graph;
+    GridPosition goal_position;
+};
+
+// Octile distance to the goal node position, holding its own copy of the view
+class AbstractOctileHeuristic {
+public:
+    AbstractOctileHeuristic(const AbstractGraphView &graph, std::size_t goal_index)
+        : graph(graph), goal_position(graph.get_position(goal_index)) {}
+
+    double operator()(std::size_t index) const {
+        return distance(graph.get_position(index), goal_position);
+    }
+
+private:
+    AbstractGraphView graph;
+    AbstractPosition goal_position;
+};
+
+// Exact octile distance to the box bounding several goal cells, which never exceeds the distance to the nearest one
+class GridBoundsHeuristic {
+public:
+    GridBoundsHeuristic(const GridGraphView &graph, const std::vector<std::size_t> &goal_indices)
+        : graph(graph), min_corner(graph.get_position(goal_indices.front())), max_corner(min_corner) {
+        for (const std::size_t goal_index : goal_indices) {
+            const GridPosition position = graph.get_position(goal_index);
+            min_corner = {std::min(min_corner.x, position.x), std::min(min_corner.y, position.y)};
+            max_corner = {std::max(max_corner.x, position.x), std::max(max_corner.y, position.y)};
+        }
+    }
+
+    OctileCost operator()(std::size_t index) const {
+        const GridPosition position = graph.get_position(index);
+        return octile_distance(position, {std::clamp(position.x, min_corner.x, max_corner.x),
+                                          std::clamp(position.y, min_corner.y, max_corner.y)});
+    }
+
+private:
+    GridGraphView graph;
+    GridPosition min_corner;
+    GridPosition max_corner;
+};
+
+// Octile distance to the box bounding several goal node positions, holding its own copy of the view
+class AbstractBoundsHeuristic {
+public:
+    AbstractBoundsHeuristic(const AbstractGraphView &graph, const std::vector<std::size_t> &goal_indices)
+        : graph(graph), min_corner(graph.get_position(goal_indices.front())), max_corner(min_corner) {
+        for (const std::size_t goal_index : goal_indices) {
+            const AbstractPosition &position = graph.get_position(goal_index);
+            min_corner = {std::min(min_corner.x, position.x), std::min(min_corner.y, position.y)};
+            max_corner = {std::max(max_corner.x, position.x), std::max(max_corner.y, position.y)};
+        }
+    }
+
+    double operator()(std::size_t index) const {
+        const AbstractPosition &position = graph.get_position(index);
+        return distance(position, AbstractPosition{std::clamp(position.x, min_corner.x, max_corner.x),
+                                                   std::clamp(position.y, min_corner.y, max_corner.y)});
+    }
+
+private:
+    AbstractGraphView graph;
+    AbstractPosition min_corner;
+    AbstractPosition max_corner;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_GRAPH_VIEW_H
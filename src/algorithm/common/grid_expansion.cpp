@@ -0,0 +1,111 @@
+// File: grid_expansion.cpp
+// Batched evaluation of the moves from an expanded layer 0 grid node
+
+#include "grid_expansion.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+#include <cstdint>
+
+namespace tpl_search {
+
+static_assert(sizeof(OctileCost) == 2 * sizeof(std::int32_t), "g-values are gathered as pairs of counts");
+
+std::size_t evaluate_grid_moves(const GridGraphView &graph, const GridOctileHeuristic &heuristic,
+                                const SearchWorkspace<OctileCost> &workspace, std::size_t index, const OctileCost &g,
+                                std::array<GridChild, NUM_GRID_MOVES> &children) {
+    const std::uint8_t move_mask = graph.get_move_mask(index);
+    if (move_mask == 0) {
+        return 0;
+    }
+    const std::array<std::uint32_t, NUM_GRID_MOVES> &targets = graph.get_move_targets(index);
+    // Cardinal moves come first, so the first half of the children take a cardinal step and the second a diagonal one
+    const OctileCost cardinal_g = g + CARDINAL_STEP;
+    const OctileCost diagonal_g = g + DIAGONAL_STEP;
+    std::size_t num_children = 0;
+
+#if defined(__AVX2__)
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i valid = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(move_mask), lane_bits), lane_bits);
+    const __m256i target_indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(targets.data()));
+
+    // Stored paths of the children, only lanes with a move are read
+    const __m256i stamps = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                                                       reinterpret_cast<const int *>(workspace.get_stamps()),
+                                                       target_indices, valid, 4);
+    const __m256i generated =
+        _mm256_cmpeq_epi32(stamps, _mm256_set1_epi32(static_cast<std::int32_t>(workspace.get_generation())));
+    const int *counts = reinterpret_cast<const int *>(workspace.get_g_values());
+    const __m256i count_offsets = _mm256_slli_epi32(target_indices, 1);
+    const __m256i stored_cardinals =
+        _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), counts, count_offsets, generated, 4);
+    const __m256i stored_diagonals =
+        _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), counts + 1, count_offsets, generated, 4);
+
+    // The child improves if cardinal + diagonal * sqrt(2) of the difference to the stored path is negative. The counts
+    // are bounded, so distinct costs differ by far more than the rounding error of the double values.
+    const __m256i child_cardinals =
+        _mm256_set_m128i(_mm_set1_epi32(diagonal_g.cardinal), _mm_set1_epi32(cardinal_g.cardinal));
+    const __m256i child_diagonals =
+        _mm256_set_m128i(_mm_set1_epi32(diagonal_g.diagonal), _mm_set1_epi32(cardinal_g.diagonal));
+    const __m256i cardinal_differences = _mm256_sub_epi32(child_cardinals, stored_cardinals);
+    const __m256i diagonal_differences = _mm256_sub_epi32(child_diagonals, stored_diagonals);
+    const __m256d sqrt_2 = _mm256_set1_pd(std::sqrt(2.0));
+    const auto is_negative = [&](__m128i cardinal, __m128i diagonal) {
+        const __m256d difference =
+            _mm256_add_pd(_mm256_cvtepi32_pd(cardinal), _mm256_mul_pd(_mm256_cvtepi32_pd(diagonal), sqrt_2));
+        return _mm256_movemask_pd(_mm256_cmp_pd(difference, _mm256_setzero_pd(), _CMP_LT_OQ));
+    };
+    const int low_improved_bits =
+        is_negative(_mm256_castsi256_si128(cardinal_differences), _mm256_castsi256_si128(diagonal_differences));
+    const int high_improved_bits = is_negative(_mm256_extracti128_si256(cardinal_differences, 1),
+                                               _mm256_extracti128_si256(diagonal_differences, 1));
+    const int improved_bits = low_improved_bits | (high_improved_bits << 4);
+    const int generated_bits = _mm256_movemask_ps(_mm256_castsi256_ps(generated));
+    unsigned int child_bits = static_cast<unsigned int>(move_mask & (~generated_bits | improved_bits));
+    if (child_bits == 0) {
+        return 0;
+    }
+
+    // Octile distance of each child to the goal
+    const GridPosition position = graph.get_position(index);
+    const GridPosition &goal_position = heuristic.get_goal_position();
+    const auto offsets = [](std::size_t coordinate, std::size_t goal_coordinate, const auto &moves) {
+        const __m256i offset = _mm256_set1_epi32(static_cast<std::int32_t>(coordinate) -
+                                                 static_cast<std::int32_t>(goal_coordinate));
+        return _mm256_add_epi32(offset, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(moves.data())));
+    };
+    const __m256i dx = _mm256_abs_epi32(offsets(position.x, goal_position.x, GRID_MOVE_DX));
+    const __m256i dy = _mm256_abs_epi32(offsets(position.y, goal_position.y, GRID_MOVE_DY));
+    const __m256i h_diagonals = _mm256_min_epi32(dx, dy);
+    const __m256i h_cardinals = _mm256_sub_epi32(_mm256_max_epi32(dx, dy), h_diagonals);
+    alignas(32) std::int32_t f_cardinals[NUM_GRID_MOVES];
+    alignas(32) std::int32_t f_diagonals[NUM_GRID_MOVES];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(f_cardinals), _mm256_add_epi32(child_cardinals, h_cardinals));
+    _mm256_store_si256(reinterpret_cast<__m256i *>(f_diagonals), _mm256_add_epi32(child_diagonals, h_diagonals));
+
+    for (; child_bits != 0; child_bits &= child_bits - 1) {
+        const std::size_t move = static_cast<std::size_t>(__builtin_ctz(child_bits));
+        const OctileCost &child_g = move < NUM_CARDINAL_MOVES ? cardinal_g : diagonal_g;
+        children[num_children++] = {targets[move], child_g, {f_cardinals[move], f_diagonals[move]}};
+    }
+#else
+    for (std::size_t move = 0; move < NUM_GRID_MOVES; ++move) {
+        if ((move_mask & (1 << move)) == 0) {
+            continue;
+        }
+        const std::size_t child_index = targets[move];
+        const OctileCost &child_g = move < NUM_CARDINAL_MOVES ? cardinal_g : diagonal_g;
+        if (workspace.is_generated(child_index) && !(child_g < workspace.get_g(child_index))) {
+            continue;
+        }
+        children[num_children++] = {child_index, child_g, child_g + heuristic(child_index)};
+    }
+#endif
+    return num_children;
+}
+
+}    // namespace tpl_search
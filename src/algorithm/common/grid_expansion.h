@@ -0,0 +1,44 @@
+// File: grid_expansion.h
+// Batched evaluation of the moves from an expanded layer 0 grid node
+
+#ifndef PRA_ALGORITHM_COMMON_GRID_EXPANSION_H
+#define PRA_ALGORITHM_COMMON_GRID_EXPANSION_H
+
+#include <array>
+
+#include "graph.h"
+#include "graph_view.h"
+#include "octile_cost.h"
+#include "search_context.h"
+
+namespace tpl_search {
+
+// Child of an expanded node whose path is better than the one stored for it
+struct GridChild {
+    std::size_t index;
+    OctileCost g;
+    OctileCost f;
+};
+
+/**
+ * Evaluate all moves from an expanded node of the layer 0 grid at once.
+ * The neighbours come from the move mask of the node. The g-, h- and f-values of all of them are computed together,
+ * and children already generated with a path at least as good are dropped. With AVX2 this is a single 8 lane pass over
+ * the moves, otherwise the moves are evaluated one at a time.
+ * @note Counts must stay below OctileCost::MAX_FIXED_CARDINAL and MAX_FIXED_DIAGONAL, as g-values are compared in
+ * double precision
+ * @param graph The grid being searched
+ * @param heuristic Octile distance to the goal
+ * @param workspace Workspace of the search
+ * @param index Dense index of the expanded node
+ * @param g The g-value of the expanded node
+ * @param children Storage for the children found
+ * @return Number of children written to children, in the order of the moves
+ */
+std::size_t evaluate_grid_moves(const GridGraphView &graph, const GridOctileHeuristic &heuristic,
+                                const SearchWorkspace<OctileCost> &workspace, std::size_t index, const OctileCost &g,
+                                std::array<GridChild, NUM_GRID_MOVES> &children);
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_GRID_EXPANSION_H
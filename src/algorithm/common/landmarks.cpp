@@ -0,0 +1,289 @@
+// File: landmarks.cpp
+// Landmark distance tables and the ALT heuristic
+
+#include "landmarks.h"
+
+#include <nop/serializer.h>
+#include <nop/utility/stream_reader.h>
+#include <nop/utility/stream_writer.h>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+
+#include "util/file_util.h"
+
+namespace tpl_search {
+
+namespace {
+
+// Relative bound on the error of the single precision landmark bounds, with room to spare
+constexpr float ROUNDING_MARGIN = 1.0f / static_cast<float>(1 << 20);
+
+/**
+ * Compute exact distances from a node to every node of a grid with Dijkstra's algorithm
+ * @param view The grid to search over
+ * @param source_index Dense index of the source node
+ * @param reached Set to whether each node can be reached from the source
+ * @return Distance to each node, zero if the node can't be reached
+ */
+std::vector<OctileCost> grid_distances(const GridGraphView &view, std::size_t source_index,
+                                       std::vector<std::uint8_t> &reached) {
+    using Entry = std::pair<OctileCost, std::size_t>;
+    const auto later = [](const Entry &left, const Entry &right) { return right.first < left.first; };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(later)> open(later);
+    std::vector<OctileCost> g_values(view.num_nodes());
+    std::vector<std::uint8_t> closed(view.num_nodes(), false);
+    reached.assign(view.num_nodes(), false);
+
+    reached[source_index] = true;
+    open.push({OctileCost{}, source_index});
+    while (!open.empty()) {
+        const auto [g, index] = open.top();
+        open.pop();
+        if (closed[index]) {
+            continue;
+        }
+        closed[index] = true;
+        view.for_each_neighbour(index, [&](std::size_t neighbour_index, const OctileCost &edge_cost) {
+            const OctileCost neighbour_g = g + edge_cost;
+            if (!reached[neighbour_index] || neighbour_g < g_values[neighbour_index]) {
+                reached[neighbour_index] = true;
+                g_values[neighbour_index] = neighbour_g;
+                open.push({neighbour_g, neighbour_index});
+            }
+        });
+    }
+    return g_values;
+}
+
+/**
+ * Find a node of the largest connected component
+ * @param graph The graph to search
+ * @return Dense index of a node in the largest component
+ */
+std::size_t largest_component_node(const FlatGraph &graph) {
+    std::vector<std::uint8_t> visited(graph.num_nodes(), false);
+    std::vector<std::size_t> stack;
+    std::size_t best_node = 0;
+    std::size_t best_size = 0;
+    for (std::size_t root = 0; root < graph.num_nodes(); ++root) {
+        if (visited[root]) {
+            continue;
+        }
+        std::size_t size = 0;
+        visited[root] = true;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const std::size_t index = stack.back();
+            stack.pop_back();
+            ++size;
+            for (const std::size_t neighbour_index : graph.get_neighbour_indices(index)) {
+                if (!visited[neighbour_index]) {
+                    visited[neighbour_index] = true;
+                    stack.push_back(neighbour_index);
+                }
+            }
+        }
+        if (size > best_size) {
+            best_size = size;
+            best_node = root;
+        }
+    }
+    return best_node;
+}
+
+/**
+ * Find the node farthest from the picked landmarks
+ * @param min_distances Distance from each node to its closest landmark, negative if unreachable
+ * @return Dense index of the farthest node
+ */
+std::size_t farthest_node(const std::vector<double> &min_distances) {
+    return static_cast<std::size_t>(std::max_element(min_distances.begin(), min_distances.end()) -
+                                    min_distances.begin());
+}
+
+}    // namespace
+
+LandmarkTable::LandmarkTable(const FlatGraph &graph, std::size_t num_landmarks) {
+    assert(graph.is_grid_graph() && num_landmarks <= MAX_LANDMARKS);
+    const GridGraphView view(graph);
+    if (graph.num_nodes() == 0) {
+        return;
+    }
+
+    // The first landmark is the node farthest from an arbitrary node, each next one the node farthest from all
+    // landmarks picked so far
+    std::vector<std::uint8_t> reached;
+    const std::vector<OctileCost> seed_distances = grid_distances(view, largest_component_node(graph), reached);
+    std::vector<double> min_distances(graph.num_nodes(), -1);
+    for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+        if (reached[index]) {
+            min_distances[index] = seed_distances[index].to_double();
+        }
+    }
+    std::vector<std::vector<OctileCost>> landmark_distances;
+    while (landmark_indices.size() < num_landmarks) {
+        const std::size_t landmark_index = farthest_node(min_distances);
+        if (min_distances[landmark_index] <= 0 && !landmark_indices.empty()) {
+            break;
+        }
+        landmark_indices.push_back(landmark_index);
+        landmark_distances.push_back(grid_distances(view, landmark_index, reached));
+        for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+            const double distance = reached[index] ? landmark_distances.back()[index].to_double() : -1;
+            min_distances[index] = landmark_indices.size() == 1 ? distance : std::min(min_distances[index], distance);
+        }
+    }
+
+    // Unreachable nodes and the padding store zero
+    stride = (landmark_indices.size() + LANDMARK_SIMD_WIDTH - 1) / LANDMARK_SIMD_WIDTH * LANDMARK_SIMD_WIDTH;
+    cardinals.assign(graph.num_nodes() * stride, 0);
+    diagonals.assign(graph.num_nodes() * stride, 0);
+    for (std::size_t landmark = 0; landmark < landmark_indices.size(); ++landmark) {
+        for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+            cardinals[index * stride + landmark] = landmark_distances[landmark][index].cardinal;
+            diagonals[index * stride + landmark] = landmark_distances[landmark][index].diagonal;
+        }
+    }
+    update_rounding_tolerance();
+}
+
+OctileCost LandmarkTable::lower_bound(std::size_t index, std::size_t goal_index) const {
+    assert(stride <= MAX_LANDMARKS);
+    const std::int32_t *node_cardinals = cardinals.data() + index * stride;
+    const std::int32_t *node_diagonals = diagonals.data() + index * stride;
+    const std::int32_t *goal_cardinals = cardinals.data() + goal_index * stride;
+    const std::int32_t *goal_diagonals = diagonals.data() + goal_index * stride;
+    const float sqrt_2 = static_cast<float>(std::sqrt(2.0));
+
+    // Bound |d(l, node) - d(l, goal)| of every landmark in single precision
+    alignas(32) float bounds[MAX_LANDMARKS];
+#if defined(__AVX__)
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const auto value = [sqrt_2](const std::int32_t *cardinal, const std::int32_t *diagonal) {
+        const auto load = [](const std::int32_t *counts) {
+            return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(counts)));
+        };
+        return _mm256_add_ps(load(cardinal), _mm256_mul_ps(load(diagonal), _mm256_set1_ps(sqrt_2)));
+    };
+    __m256 best = _mm256_setzero_ps();
+    for (std::size_t i = 0; i < stride; i += 8) {
+        const __m256 difference = _mm256_sub_ps(value(node_cardinals + i, node_diagonals + i),
+                                                value(goal_cardinals + i, goal_diagonals + i));
+        const __m256 bound = _mm256_andnot_ps(sign_mask, difference);
+        best = _mm256_max_ps(best, bound);
+        _mm256_store_ps(bounds + i, bound);
+    }
+    __m128 lanes = _mm_max_ps(_mm256_castps256_ps128(best), _mm256_extractf128_ps(best, 1));
+#elif defined(__SSE2__)
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const auto value = [sqrt_2](const std::int32_t *cardinal, const std::int32_t *diagonal) {
+        const __m128 cardinal_value = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(cardinal)));
+        const __m128 diagonal_value = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(diagonal)));
+        return _mm_add_ps(cardinal_value, _mm_mul_ps(diagonal_value, _mm_set1_ps(sqrt_2)));
+    };
+    __m128 lanes = _mm_setzero_ps();
+    for (std::size_t i = 0; i < stride; i += 4) {
+        const __m128 difference =
+            _mm_sub_ps(value(node_cardinals + i, node_diagonals + i), value(goal_cardinals + i, goal_diagonals + i));
+        const __m128 bound = _mm_andnot_ps(sign_mask, difference);
+        lanes = _mm_max_ps(lanes, bound);
+        _mm_store_ps(bounds + i, bound);
+    }
+#endif
+#if defined(__AVX__) || defined(__SSE2__)
+    // Reduce the four lanes to one
+    lanes = _mm_max_ps(lanes, _mm_movehl_ps(lanes, lanes));
+    lanes = _mm_max_ss(lanes, _mm_shuffle_ps(lanes, lanes, 1));
+    const float best_bound = _mm_cvtss_f32(lanes);
+#else
+    float best_bound = 0;
+    for (std::size_t i = 0; i < stride; ++i) {
+        const float node_value = static_cast<float>(node_cardinals[i]) + static_cast<float>(node_diagonals[i]) * sqrt_2;
+        const float goal_value = static_cast<float>(goal_cardinals[i]) + static_cast<float>(goal_diagonals[i]) * sqrt_2;
+        bounds[i] = std::abs(node_value - goal_value);
+        best_bound = std::max(best_bound, bounds[i]);
+    }
+#endif
+    if (best_bound == 0) {
+        return {};
+    }
+
+    // Landmarks within the rounding error of the best are compared exactly, so the largest bound is always returned
+    // and the heuristic stays consistent
+    OctileCost best_exact;
+    for (std::size_t landmark = 0; landmark < landmark_indices.size(); ++landmark) {
+        if (bounds[landmark] < best_bound - rounding_tolerance) {
+            continue;
+        }
+        const OctileCost difference = get_distance(landmark, index) - get_distance(landmark, goal_index);
+        best_exact = std::max(best_exact, difference < OctileCost{} ? OctileCost{} - difference : difference);
+    }
+    return best_exact;
+}
+
+void LandmarkTable::update_rounding_tolerance() {
+    // Single precision values and their differences are within a few units in the last place of the largest distance
+    float max_distance = 0;
+    for (std::size_t i = 0; i < cardinals.size(); ++i) {
+        max_distance = std::max(max_distance, static_cast<float>(OctileCost{cardinals[i], diagonals[i]}.to_double()));
+    }
+    rounding_tolerance = max_distance * ROUNDING_MARGIN;
+}
+
+void LandmarkTable::save(const std::string &path) const {
+    if (!std::filesystem::exists(std::filesystem::path(path).parent_path())) {
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    }
+    std::filesystem::remove(path);
+    std::cout << "Exporting LandmarkTable to " << path << std::endl;
+    nop::Serializer<nop::StreamWriter<std::ofstream>> serializer{path};
+
+    serializer.Write(this->landmark_indices);
+    serializer.Write(this->stride);
+    serializer.Write(this->cardinals);
+    serializer.Write(this->diagonals);
+}
+
+void LandmarkTable::load(const std::string &path) {
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "Error: " << path << " does not exist." << std::endl;
+        exit(1);
+    }
+    std::cout << "Loading LandmarkTable from " << path << std::endl;
+    nop::Deserializer<nop::StreamReader<std::ifstream>> deserializer{path};
+
+    deserializer.Read(&(this->landmark_indices));
+    deserializer.Read(&(this->stride));
+    deserializer.Read(&(this->cardinals));
+    deserializer.Read(&(this->diagonals));
+    update_rounding_tolerance();
+}
+
+LandmarkTable load_landmarks(const std::string &map_path, const FlatGraph &graph, bool force_create) {
+    // Check if landmark table is already cached
+    std::filesystem::path landmarks_path = map_to_landmarks_path(map_path);
+    if (std::filesystem::exists(landmarks_path) && !force_create) {
+        LandmarkTable landmarks;
+        landmarks.load(landmarks_path);
+        if (landmarks.num_nodes() != graph.num_nodes()) {
+            std::cerr << "Error: " << landmarks_path << " does not match the graph of " << map_path << std::endl;
+            exit(1);
+        }
+        return landmarks;
+    }
+
+    // Otherwise we need to create
+    return LandmarkTable(graph);
+}
+
+}    // namespace tpl_search
@@ -0,0 +1,123 @@
+// File: landmarks.h
+// Landmark distance tables and the ALT heuristic
+
+#ifndef PRA_ALGORITHM_COMMON_LANDMARKS_H
+#define PRA_ALGORITHM_COMMON_LANDMARKS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "graph_view.h"
+#include "octile_cost.h"
+
+namespace tpl_search {
+
+// Exact distances from a few landmark nodes to every node of the layer 0 grid, which bound the distance between any
+// two nodes through the triangle inequality.
+// Landmarks are picked by farthest point selection within the largest connected component. Distances are stored as
+// exact step counts, node by node and padded to a multiple of LANDMARK_SIMD_WIDTH, so the bounds of all landmarks of a
+// node are evaluated together. Nodes which can't reach a landmark store zero for it, their bounds only matter between
+// different components where no path exists.
+class LandmarkTable {
+public:
+    static constexpr std::size_t LANDMARK_SIMD_WIDTH = 8;
+    static constexpr std::size_t DEFAULT_NUM_LANDMARKS = 16;
+    static constexpr std::size_t MAX_LANDMARKS = 64;
+
+    LandmarkTable() = default;
+
+    /**
+     * Pick landmarks and compute their distances
+     * @param graph The layer 0 grid graph
+     * @param num_landmarks Number of landmarks to pick, at most MAX_LANDMARKS, fewer are picked if the component runs
+     * out of nodes
+     */
+    LandmarkTable(const FlatGraph &graph, std::size_t num_landmarks = DEFAULT_NUM_LANDMARKS);
+
+    std::size_t num_nodes() const {
+        return stride == 0 ? 0 : cardinals.size() / stride;
+    }
+
+    /**
+     * Get the picked landmarks
+     * @return Dense indices of the landmark nodes
+     */
+    const std::vector<std::size_t> &get_landmark_indices() const {
+        return landmark_indices;
+    }
+
+    /**
+     * Get the distance between a landmark and a node
+     * @param landmark Position of the landmark in get_landmark_indices()
+     * @param index Dense index of the node
+     * @return Exact distance, zero if the node can't reach the landmark
+     */
+    OctileCost get_distance(std::size_t landmark, std::size_t index) const {
+        return {cardinals[index * stride + landmark], diagonals[index * stride + landmark]};
+    }
+
+    /**
+     * Lower bound of the distance between two nodes, the largest triangle inequality bound over all landmarks
+     * @note The bounds of all landmarks are evaluated together in single precision, then those close to the largest are
+     * compared exactly, so the result is exactly the largest bound
+     * @param index Dense index of the first node
+     * @param goal_index Dense index of the second node
+     * @return Lower bound of the distance, one of its counts may be negative but never its value
+     */
+    OctileCost lower_bound(std::size_t index, std::size_t goal_index) const;
+
+    /**
+     * Save the table to the given path
+     * @param path Path to serialize the table
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * Load the table from a given path
+     * @param path Path to load the table from
+     */
+    void load(const std::string &path);
+
+private:
+    // Set the margin below the best single precision bound within which bounds are compared exactly
+    void update_rounding_tolerance();
+
+    std::vector<std::size_t> landmark_indices;
+    std::size_t stride = 0;                  // Entries per node, the number of landmarks padded to LANDMARK_SIMD_WIDTH
+    std::vector<std::int32_t> cardinals;     // Node major, stride per node
+    std::vector<std::int32_t> diagonals;     // Node major, stride per node
+    float rounding_tolerance = 0;
+};
+
+// ALT heuristic over the layer 0 grid, the larger of the octile distance and the landmark bound to the goal
+class LandmarkHeuristic {
+public:
+    LandmarkHeuristic(const GridGraphView &graph, const LandmarkTable &landmarks, std::size_t goal_index)
+        : octile(graph, goal_index), landmarks(landmarks), goal_index(goal_index) {}
+
+    OctileCost operator()(std::size_t index) const {
+        return std::max(octile(index), landmarks.lower_bound(index, goal_index));
+    }
+
+private:
+    GridOctileHeuristic octile;
+    const LandmarkTable &landmarks;
+    std::size_t goal_index;
+};
+
+/**
+ * Load the landmark table for a map path
+ * @note If result hasn't been cached to disk, will be created on the fly
+ * @param map_path Path to map file
+ * @param graph The layer 0 grid graph of the map
+ * @param force_create Force create the table even if it already exists on disk
+ * @return Landmark table of the map
+ */
+LandmarkTable load_landmarks(const std::string &map_path, const FlatGraph &graph, bool force_create = false);
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_LANDMARKS_H
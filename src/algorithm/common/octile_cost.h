@@ -0,0 +1,116 @@
+// File: octile_cost.h
+// Exact octile path cost
+
+#ifndef PRA_ALGORITHM_COMMON_OCTILE_COST_H
+#define PRA_ALGORITHM_COMMON_OCTILE_COST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+
+#include "graph.h"
+
+namespace tpl_search {
+
+// Cost on an 8-connected grid, held as a count of cardinal and diagonal steps so that the value cardinal +
+// diagonal * sqrt(2) is represented exactly. Counts of path costs are never negative, differences of path costs may
+// have one negative count.
+struct OctileCost {
+    // Scale of the fixed point encoding
+    static constexpr int FIXED_POINT_BITS = 20;
+    // Largest counts for which the fixed point encoding preserves the exact ordering
+    static constexpr std::int32_t MAX_FIXED_CARDINAL = 1 << 17;
+    static constexpr std::int32_t MAX_FIXED_DIAGONAL = 1 << 16;
+
+    std::int32_t cardinal = 0;
+    std::int32_t diagonal = 0;
+
+    OctileCost operator+(const OctileCost &other) const {
+        return {cardinal + other.cardinal, diagonal + other.diagonal};
+    }
+
+    OctileCost operator-(const OctileCost &other) const {
+        return {cardinal - other.cardinal, diagonal - other.diagonal};
+    }
+
+    OctileCost &operator+=(const OctileCost &other) {
+        cardinal += other.cardinal;
+        diagonal += other.diagonal;
+        return *this;
+    }
+
+    bool operator==(const OctileCost &other) const = default;
+
+    // Exact ordering of a1 + b1 * sqrt(2) against a2 + b2 * sqrt(2) using only integer arithmetic
+    std::strong_ordering operator<=>(const OctileCost &other) const {
+        // Compare x against y * sqrt(2)
+        const std::int64_t x = static_cast<std::int64_t>(cardinal) - other.cardinal;
+        const std::int64_t y = static_cast<std::int64_t>(other.diagonal) - diagonal;
+        if (x == 0 && y == 0) {
+            return std::strong_ordering::equal;
+        }
+        if (x <= 0 && y >= 0) {
+            return std::strong_ordering::less;
+        }
+        if (x >= 0 && y <= 0) {
+            return std::strong_ordering::greater;
+        }
+        // Same signs, sqrt(2) is irrational so the squares can never tie
+        const std::int64_t x_sq = x * x;
+        const std::int64_t y_sq_2 = 2 * y * y;
+        return (x > 0) == (x_sq < y_sq_2) ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+
+    /**
+     * Convert to the closest double value
+     * @return cardinal + diagonal * sqrt(2)
+     */
+    double to_double() const {
+        return static_cast<double>(cardinal) + std::sqrt(2.0) * static_cast<double>(diagonal);
+    }
+
+    /**
+     * Encode as floor((cardinal + diagonal * sqrt(2)) * 2^FIXED_POINT_BITS)
+     * @note The encoding is strictly order preserving while the counts are below MAX_FIXED_CARDINAL and
+     * MAX_FIXED_DIAGONAL, as distinct costs in that range differ by more than 2^-FIXED_POINT_BITS
+     * @return Fixed point encoding of the cost
+     */
+    std::uint64_t to_fixed() const {
+        assert(cardinal < MAX_FIXED_CARDINAL && diagonal < MAX_FIXED_DIAGONAL);
+        // floor(diagonal * sqrt(2) * 2^B) = isqrt(diagonal^2 * 2^(2B + 1))
+        const unsigned __int128 target = static_cast<unsigned __int128>(static_cast<std::uint64_t>(diagonal) *
+                                                                       static_cast<std::uint64_t>(diagonal))
+                                         << (2 * FIXED_POINT_BITS + 1);
+        auto root = static_cast<std::uint64_t>(std::sqrt(static_cast<long double>(target)));
+        while (static_cast<unsigned __int128>(root) * root > target) {
+            --root;
+        }
+        while (static_cast<unsigned __int128>(root + 1) * (root + 1) <= target) {
+            ++root;
+        }
+        return (static_cast<std::uint64_t>(cardinal) << FIXED_POINT_BITS) + root;
+    }
+};
+
+// Single step costs
+constexpr OctileCost CARDINAL_STEP{1, 0};
+constexpr OctileCost DIAGONAL_STEP{0, 1};
+
+/**
+ * Compute exact octile distance between two grid positions
+ * @param p1 Grid position of first point
+ * @param p2 Grid position of second point
+ * @return distance between the two points
+ */
+inline OctileCost octile_distance(const GridPosition &p1, const GridPosition &p2) {
+    const std::size_t adx = p1.x > p2.x ? p1.x - p2.x : p2.x - p1.x;
+    const std::size_t ady = p1.y > p2.y ? p1.y - p2.y : p2.y - p1.y;
+    const std::size_t diagonal = std::min(adx, ady);
+    return {static_cast<std::int32_t>(std::max(adx, ady) - diagonal), static_cast<std::int32_t>(diagonal)};
+}
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_OCTILE_COST_H
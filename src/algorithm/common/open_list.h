@@ -0,0 +1,349 @@
+// File: open_list.h
+// Open list implementations used in search
+
+#ifndef PRA_ALGORITHM_COMMON_OPEN_LIST_H
+#define PRA_ALGORITHM_COMMON_OPEN_LIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "octile_cost.h"
+#include "util/bucket_queue.h"
+
+namespace tpl_search {
+
+// Types of open lists
+enum class OpenListType { PrioritySet, BucketQueue };
+
+// Node used in the open list, referencing the graph node by its dense index
+template <typename CostT>
+struct SearchNode {
+    std::size_t index;
+    CostT g{};
+    CostT f{};
+
+    // Hashing
+    struct Hasher {
+        std::size_t operator()(const SearchNode &node) const {
+            return node.index;
+        }
+    };
+};
+
+// Tie-breaking policies, ordering nodes by f-cost and then g-cost on ties
+// Larger g first, which favours nodes closer to the goal
+struct TieBreakHighG {
+    template <typename CostT>
+    bool operator()(const SearchNode<CostT> &left, const SearchNode<CostT> &right) const {
+        return left.f < right.f || (left.f == right.f && left.g > right.g);
+    }
+};
+
+// Smaller g first, which favours nodes closer to the start
+struct TieBreakLowG {
+    template <typename CostT>
+    bool operator()(const SearchNode<CostT> &left, const SearchNode<CostT> &right) const {
+        return left.f < right.f || (left.f == right.f && left.g < right.g);
+    }
+};
+
+/**
+ * Fixed point key of a cost, order preserving
+ * @param cost The cost to encode
+ * @return Integer key of the cost
+ */
+inline std::uint64_t fixed_point_key(const OctileCost &cost) {
+    return cost.to_fixed();
+}
+
+/**
+ * Fixed point key of a cost, order preserving but not strictly
+ * @param cost The cost to encode
+ * @return Integer key of the cost
+ */
+inline std::uint64_t fixed_point_key(double cost) {
+    return static_cast<std::uint64_t>(std::ldexp(cost, OctileCost::FIXED_POINT_BITS));
+}
+
+// Open list on an indexed binary heap, priorities are updated in place. The heap position of each node is held in a
+// dense array by node index, only valid while the node's stamp is the current generation, so pushing and popping
+// don't allocate once the arrays have grown and clearing doesn't depend on the size of the graph.
+template <typename CostT, typename TieBreakT = TieBreakHighG>
+class HeapOpenList {
+public:
+    using Node = SearchNode<CostT>;
+
+    /**
+     * Grow the storage so a graph with the given number of nodes can be held without further allocation
+     * @param num_nodes Number of nodes to support
+     */
+    void reserve(std::size_t num_nodes) {
+        if (num_nodes > positions.size()) {
+            positions.resize(num_nodes);
+            stamps.resize(num_nodes, 0);
+        }
+    }
+
+    // Positions are only cleared when the generation counter wraps around, the heap keeps its capacity
+    void clear() {
+        heap.clear();
+        ++generation;
+        if (generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    std::size_t size() const {
+        return heap.size();
+    }
+
+    // Nodes already in the open list are left unchanged
+    void push(const Node &node) {
+        if (contains(node.index)) {
+            return;
+        }
+        reserve(node.index + 1);
+        stamps[node.index] = generation;
+        heap.push_back(node);
+        positions[node.index] = heap.size() - 1;
+        swim(heap.size() - 1);
+    }
+
+    // Node with a better path is already in the open list
+    void decrease(const Node &node) {
+        if (!contains(node.index)) {
+            return;
+        }
+        const std::size_t position = positions[node.index];
+        heap[position] = node;
+        swim(position);
+        sink(position);
+    }
+
+    const Node &top() const {
+        return heap.front();
+    }
+
+    bool contains(std::size_t index) const {
+        return index < stamps.size() && stamps[index] == generation;
+    }
+
+    Node pop() {
+        const Node node = heap.front();
+        swap_nodes(0, heap.size() - 1);
+        stamps[node.index] = 0;
+        heap.pop_back();
+        sink(0);
+        return node;
+    }
+
+private:
+    void swap_nodes(std::size_t position1, std::size_t position2) {
+        std::swap(heap[position1], heap[position2]);
+        positions[heap[position1].index] = position1;
+        positions[heap[position2].index] = position2;
+    }
+
+    void swim(std::size_t position) {
+        while (position > 0) {
+            const std::size_t parent = (position - 1) / 2;
+            if (!compare(heap[position], heap[parent])) {
+                return;
+            }
+            swap_nodes(position, parent);
+            position = parent;
+        }
+    }
+
+    void sink(std::size_t position) {
+        while (true) {
+            const std::size_t left = position * 2 + 1;
+            const std::size_t right = position * 2 + 2;
+            std::size_t swap_position = position;
+            if (left < heap.size() && compare(heap[left], heap[swap_position])) {
+                swap_position = left;
+            }
+            if (right < heap.size() && compare(heap[right], heap[swap_position])) {
+                swap_position = right;
+            }
+            if (swap_position == position) {
+                return;
+            }
+            swap_nodes(position, swap_position);
+            position = swap_position;
+        }
+    }
+
+    TieBreakT compare;
+    std::vector<Node> heap;
+    std::uint32_t generation = 1;          // Stamp of the nodes in the heap, 0 is never current
+    std::vector<std::size_t> positions;    // Position in the heap of each node by dense index
+    std::vector<std::uint32_t> stamps;     // Generation each node was last pushed in, 0 once popped
+};
+
+// Open list on a bucket queue over fixed point f-values, with the tie-breaking policy ordering each bucket.
+// Better paths are pushed as duplicates, so popped nodes must be checked for staleness by the caller.
+template <typename CostT, typename TieBreakT = TieBreakHighG>
+class BucketOpenList {
+public:
+    using Node = SearchNode<CostT>;
+
+    // Buckets cover 1/4 of a unit cost
+    static constexpr unsigned int BUCKET_SHIFT = OctileCost::FIXED_POINT_BITS - 2;
+
+    void clear() {
+        open.clear();
+    }
+
+    bool empty() const {
+        return open.empty();
+    }
+
+    std::size_t size() const {
+        return open.size();
+    }
+
+    void push(const Node &node) {
+        open.push(node, fixed_point_key(node.f));
+    }
+
+    // Node with a better path is already in the open list
+    void decrease(const Node &node) {
+        open.push(node, fixed_point_key(node.f));
+    }
+
+    Node pop() {
+        Node node = open.top();
+        open.pop();
+        return node;
+    }
+
+private:
+    BucketQueue<Node, TieBreakT> open{BUCKET_SHIFT};
+};
+
+// Open list of Fringe search, a doubly linked list over dense node indices swept in order rather than sorted.
+// Links and f-values are held in flat arrays indexed by node. Membership is not tracked, callers must only remove or
+// insert after nodes they know to be in the list. Clearing only drops the head, so the setup cost of a query does not
+// depend on the size of the graph.
+template <typename CostT>
+class FringeOpenList {
+public:
+    static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Grow the storage so a graph with the given number of nodes can be held without further allocation
+     * @param num_nodes Number of nodes to support
+     */
+    void reserve(std::size_t num_nodes) {
+        if (num_nodes > next_indices.size()) {
+            next_indices.resize(num_nodes, NONE);
+            previous_indices.resize(num_nodes, NONE);
+            f_values.resize(num_nodes);
+        }
+    }
+
+    void clear() {
+        head = NONE;
+    }
+
+    bool empty() const {
+        return head == NONE;
+    }
+
+    /**
+     * Get the first node of the list
+     * @return Dense index of the first node, NONE if empty
+     */
+    std::size_t front() const {
+        return head;
+    }
+
+    /**
+     * Get the node after a node of the list
+     * @param index Dense index of a node in the list
+     * @return Dense index of the next node, NONE if last
+     */
+    std::size_t next(std::size_t index) const {
+        return next_indices[index];
+    }
+
+    /**
+     * Get the f-value a node was inserted with
+     * @param index Dense index of a node in the list
+     * @return The f-value of the node
+     */
+    const CostT &get_f(std::size_t index) const {
+        return f_values[index];
+    }
+
+    /**
+     * Insert a node at the front of the list
+     * @param index Dense index of a node not in the list
+     * @param f The f-value of the node
+     */
+    void push_front(std::size_t index, const CostT &f) {
+        link(NONE, index, head, f);
+    }
+
+    /**
+     * Insert a node right after a node of the list
+     * @param position Dense index of a node in the list
+     * @param index Dense index of a node not in the list
+     * @param f The f-value of the node
+     */
+    void insert_after(std::size_t position, std::size_t index, const CostT &f) {
+        assert(position != index);
+        link(position, index, next_indices[position], f);
+    }
+
+    /**
+     * Remove a node from the list
+     * @param index Dense index of a node in the list
+     */
+    void remove(std::size_t index) {
+        const std::size_t previous = previous_indices[index];
+        const std::size_t next = next_indices[index];
+        if (previous == NONE) {
+            head = next;
+        } else {
+            next_indices[previous] = next;
+        }
+        if (next != NONE) {
+            previous_indices[next] = previous;
+        }
+    }
+
+private:
+    void link(std::size_t previous, std::size_t index, std::size_t next, const CostT &f) {
+        previous_indices[index] = previous;
+        next_indices[index] = next;
+        f_values[index] = f;
+        if (previous == NONE) {
+            head = index;
+        } else {
+            next_indices[previous] = index;
+        }
+        if (next != NONE) {
+            previous_indices[next] = index;
+        }
+    }
+
+    std::size_t head = NONE;
+    std::vector<std::size_t> next_indices;
+    std::vector<std::size_t> previous_indices;
+    std::vector<CostT> f_values;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_OPEN_LIST_H
@@ -0,0 +1,26 @@
+// File: search_budget.h
+// Limits on the work done by a search
+
+#ifndef PRA_ALGORITHM_COMMON_SEARCH_BUDGET_H
+#define PRA_ALGORITHM_COMMON_SEARCH_BUDGET_H
+
+#include <cstddef>
+
+namespace tpl_search {
+
+// Work a search may do before it stops, zero means no limit
+struct SearchBudget {
+    std::size_t max_expanded = 0;
+    double seconds_limit = 0;    // Thread CPU time
+
+    bool is_limited() const {
+        return max_expanded > 0 || seconds_limit > 0;
+    }
+};
+
+// State of a search which can be stopped by its budget
+enum class SearchStatus { InProgress, Solved, NoPath };
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_SEARCH_BUDGET_H
@@ -0,0 +1,74 @@
+// File: search_concepts.h
+// Concepts constraining the policies of the generic search algorithms
+
+#ifndef PRA_ALGORITHM_COMMON_SEARCH_CONCEPTS_H
+#define PRA_ALGORITHM_COMMON_SEARCH_CONCEPTS_H
+
+#include <concepts>
+#include <cstdint>
+
+#include "octile_cost.h"
+#include "open_list.h"
+
+namespace tpl_search {
+
+/**
+ * Convert a path cost to a double for reporting
+ * @param cost The cost to convert
+ * @return The cost as a double
+ */
+inline double cost_to_double(const OctileCost &cost) {
+    return cost.to_double();
+}
+
+/**
+ * Convert a path cost to a double for reporting
+ * @param cost The cost to convert
+ * @return The cost as a double
+ */
+inline double cost_to_double(double cost) {
+    return cost;
+}
+
+// Path cost, totally ordered and closed under addition with the default value as zero
+template <typename CostT>
+concept SearchCost = std::regular<CostT> && std::totally_ordered<CostT> && requires(const CostT &a, const CostT &b) {
+    { a + b } -> std::same_as<CostT>;
+    { cost_to_double(a) } -> std::same_as<double>;
+};
+
+// Graph searched over dense node indices in [0, num_nodes()).
+// for_each_neighbour calls the visitor with the dense index of each neighbour and the cost of the edge to it.
+template <typename GraphT, typename CostT>
+concept SearchGraph = SearchCost<CostT> &&
+                      requires(const GraphT &graph, std::size_t index, void (*visit)(std::size_t, const CostT &)) {
+                          { graph.num_nodes() } -> std::convertible_to<std::size_t>;
+                          { graph.get_node_id(index) } -> std::convertible_to<std::size_t>;
+                          graph.for_each_neighbour(index, visit);
+                      };
+
+// Estimate of the cost from a dense node index to the goal the heuristic was built for
+template <typename HeuristicT, typename CostT>
+concept SearchHeuristic = SearchCost<CostT> && requires(const HeuristicT &heuristic, std::size_t index) {
+    { heuristic(index) } -> std::same_as<CostT>;
+};
+
+// Strict weak ordering of search nodes, true if the left node should be expanded first
+template <typename TieBreakT, typename CostT>
+concept TieBreakPolicy = SearchCost<CostT> && std::default_initializable<TieBreakT> &&
+                         std::strict_weak_order<TieBreakT, const SearchNode<CostT> &, const SearchNode<CostT> &>;
+
+// Open list of search nodes. Lists which cannot decrease a key in place may push duplicates, so popped nodes can be
+// stale and must be checked by the search.
+template <typename OpenListT, typename CostT>
+concept SearchOpenList = SearchCost<CostT> && requires(OpenListT &open, const SearchNode<CostT> &node) {
+    open.clear();
+    { open.empty() } -> std::convertible_to<bool>;
+    open.push(node);
+    open.decrease(node);
+    { open.pop() } -> std::same_as<SearchNode<CostT>>;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_SEARCH_CONCEPTS_H
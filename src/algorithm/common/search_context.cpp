@@ -0,0 +1,13 @@
+// File: search_context.cpp
+// Reusable search workspace shared between queries
+
+#include "search_context.h"
+
+namespace tpl_search {
+
+SearchContext &get_thread_search_context() {
+    thread_local SearchContext context;
+    return context;
+}
+
+}    // namespace tpl_search
@@ -0,0 +1,231 @@
+// File: search_context.h
+// Reusable search workspace shared between queries
+
+#ifndef PRA_ALGORITHM_COMMON_SEARCH_CONTEXT_H
+#define PRA_ALGORITHM_COMMON_SEARCH_CONTEXT_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "octile_cost.h"
+#include "open_list.h"
+
+namespace tpl_search {
+
+constexpr std::size_t NO_PARENT = std::numeric_limits<std::size_t>::max();
+
+// Per-node search data (g-values, parents, closed flags) and the open lists storage for a given cost type.
+// Node data is invalidated by bumping a generation stamp rather than clearing, so the setup cost of a query does not
+// depend on the size of the graph. Storage only ever grows, so it ends up sized to the largest layer searched.
+template <typename CostT>
+class SearchWorkspace {
+public:
+    SearchWorkspace() = default;
+
+    /**
+     * Grow the storage so a graph with the given number of nodes can be searched without further allocation
+     * @param num_nodes Number of nodes to support
+     */
+    void reserve(std::size_t num_nodes) {
+        if (num_nodes > stamps.size()) {
+            stamps.resize(num_nodes, 0);
+            g_values.resize(num_nodes);
+            parent_indices.resize(num_nodes, NO_PARENT);
+            closed_flags.resize(num_nodes, false);
+            std::get<HeapOpenList<CostT, TieBreakHighG>>(open_lists).reserve(num_nodes);
+            std::get<HeapOpenList<CostT, TieBreakLowG>>(open_lists).reserve(num_nodes);
+        }
+    }
+
+    /**
+     * Prepare the workspace for a new query
+     * @param num_nodes Number of nodes in the graph to be searched
+     */
+    void reset(std::size_t num_nodes) {
+        reserve(num_nodes);
+
+        // Stamps are only cleared when the generation counter wraps around
+        ++generation;
+        if (generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+        std::apply([](auto &...open) { (open.clear(), ...); }, open_lists);
+    }
+
+    /**
+     * Check if a node has been generated in the current query
+     * @param index Dense index of the node
+     * @return True if the node has been generated, false otherwise
+     */
+    bool is_generated(std::size_t index) const {
+        return stamps[index] == generation;
+    }
+
+    /**
+     * Check if a node has been closed in the current query
+     * @param index Dense index of the node
+     * @return True if the node is closed, false otherwise
+     */
+    bool is_closed(std::size_t index) const {
+        return is_generated(index) && closed_flags[index];
+    }
+
+    /**
+     * Generate a node, or update its path if previously generated
+     * @note The node is marked as not closed
+     * @param index Dense index of the node
+     * @param g The cost to reach the node
+     * @param parent_index Dense index of the parent, NO_PARENT for the root
+     */
+    void generate(std::size_t index, const CostT &g, std::size_t parent_index) {
+        stamps[index] = generation;
+        g_values[index] = g;
+        parent_indices[index] = parent_index;
+        closed_flags[index] = false;
+    }
+
+    /**
+     * Mark a generated node as closed
+     * @param index Dense index of the node
+     */
+    void close(std::size_t index) {
+        closed_flags[index] = true;
+    }
+
+    /**
+     * Mark a closed node as not closed, keeping its path
+     * @param index Dense index of the node
+     */
+    void reopen(std::size_t index) {
+        closed_flags[index] = false;
+    }
+
+    /**
+     * Get the cost to reach a generated node
+     * @param index Dense index of the node
+     * @return The g-value of the node
+     */
+    const CostT &get_g(std::size_t index) const {
+        return g_values[index];
+    }
+
+    /**
+     * Get the parent of a generated node
+     * @param index Dense index of the node
+     * @return The dense index of the parent, NO_PARENT for the root
+     */
+    std::size_t get_parent(std::size_t index) const {
+        return parent_indices[index];
+    }
+
+    /**
+     * Get the generation stamp marking the nodes generated in the current query
+     * @note For kernels checking many nodes at once through get_stamps
+     * @return The current generation
+     */
+    std::uint32_t get_generation() const {
+        return generation;
+    }
+
+    /**
+     * Get the generation stamp of every node, a node is generated if its stamp is the current generation
+     * @return Pointer to the stamps by dense index
+     */
+    const std::uint32_t *get_stamps() const {
+        return stamps.data();
+    }
+
+    /**
+     * Get the g-value of every node, only valid for generated nodes
+     * @return Pointer to the g-values by dense index
+     */
+    const CostT *get_g_values() const {
+        return g_values.data();
+    }
+
+    /**
+     * Get the open list of the given type, which is empty after a reset
+     * @note Only the open list and tie-breaking combinations held in OpenLists are supported
+     * @return Reference to the open list
+     */
+    template <typename OpenListT>
+    OpenListT &get_open() {
+        return std::get<OpenListT>(open_lists);
+    }
+
+    /**
+     * Get the number of nodes the workspace can currently hold without growing
+     * @return Number of nodes supported
+     */
+    std::size_t capacity() const {
+        return stamps.size();
+    }
+
+private:
+    using OpenLists = std::tuple<HeapOpenList<CostT, TieBreakHighG>, HeapOpenList<CostT, TieBreakLowG>,
+                                 BucketOpenList<CostT, TieBreakHighG>, BucketOpenList<CostT, TieBreakLowG>,
+                                 FringeOpenList<CostT>>;
+
+    std::uint32_t generation = 0;
+    std::vector<std::uint32_t> stamps;
+    std::vector<CostT> g_values;
+    std::vector<std::size_t> parent_indices;
+    std::vector<std::uint8_t> closed_flags;
+    OpenLists open_lists;
+};
+
+// Direction of a search, bidirectional searches use a separate workspace per direction
+enum class SearchDirection { Forward = 0, Backward = 1 };
+
+// Search workspaces reused between queries, one per cost type and search direction.
+// Grid layers are searched with exact octile costs, abstract layers with double costs.
+class SearchContext {
+public:
+    SearchContext() = default;
+
+    /**
+     * Get the workspace for the given cost type
+     * @param direction Direction of the search using the workspace
+     * @return Reference to the workspace
+     */
+    template <typename CostT>
+    SearchWorkspace<CostT> &get_workspace(SearchDirection direction = SearchDirection::Forward);
+
+    /**
+     * Get the scratch storage used when generating neighbours
+     * @return Reference to the neighbour storage
+     */
+    std::vector<std::size_t> &get_neighbour_ids() {
+        return neighbour_ids;
+    }
+
+private:
+    std::array<SearchWorkspace<OctileCost>, 2> grid_workspaces;
+    std::array<SearchWorkspace<double>, 2> abstract_workspaces;
+    std::vector<std::size_t> neighbour_ids;
+};
+
+template <>
+inline SearchWorkspace<OctileCost> &SearchContext::get_workspace<OctileCost>(SearchDirection direction) {
+    return grid_workspaces[static_cast<std::size_t>(direction)];
+}
+
+template <>
+inline SearchWorkspace<double> &SearchContext::get_workspace<double>(SearchDirection direction) {
+    return abstract_workspaces[static_cast<std::size_t>(direction)];
+}
+
+/**
+ * Get the search context owned by the calling thread
+ * @return Reference to the thread local search context
+ */
+SearchContext &get_thread_search_context();
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_COMMON_SEARCH_CONTEXT_H
@@ -8,6 +8,27 @@
 
 namespace tpl_search {
 
+// Solution reported by an anytime search
+struct SolutionImprovement {
+    double path_cost = 0;
+    double suboptimality_bound = 0;    // Proven upper bound on path_cost divided by the optimal cost
+    double duration = 0;               // Time since the start of search
+    std::size_t expanded = 0;          // Expansions since the start of search
+};
+
+// Search of one level during an iteration of a hierarchical search
+struct LevelSearch {
+    std::size_t iteration = 0;        // Segment of the path being refined, or the window of the path when refined in
+                                      // parallel
+    std::size_t level = 0;
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+    double duration = 0;
+    std::size_t corridor_size = 0;    // Nodes the search was constrained to, 0 if unconstrained
+    bool is_cache_hit = false;        // Path taken from a cache, or shared by another query, without searching
+    bool is_reused = false;           // Path kept from the previous iteration without searching
+};
+
 // Result of search algorithm
 struct SearchOutput {
     std::size_t expanded = 0;
@@ -16,6 +37,10 @@ struct SearchOutput {
     double first_move_duration = 0;
     double path_cost = 0;
     std::vector<std::size_t> path_node_ids;
+    std::vector<SolutionImprovement> improvements;    // Each solution of an anytime search, empty otherwise
+    bool is_partial = false;                          // Ran out of budget, the path only leads toward the goal
+    std::size_t peak_nodes = 0;                       // Most search nodes held at once, by memory-bounded searches
+    std::vector<LevelSearch> level_searches{};        // Each level searched by a hierarchical search, empty otherwise
 };
 
 }    // namespace tpl_search
@@ -0,0 +1,136 @@
+// File: fringe.cpp
+// Fringe search algorithm
+
+#include "fringe.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include "util/timer.h"
+
+namespace tpl_search {
+
+namespace {
+
+template <typename GraphT, typename CostT>
+std::vector<std::size_t> reconstruct_path(const GraphT &graph, const SearchWorkspace<CostT> &workspace,
+                                          std::size_t current_index) {
+    assert(current_index != NO_PARENT);
+    std::vector<std::size_t> path;
+    while (current_index != NO_PARENT) {
+        path.push_back(graph.get_node_id(current_index));
+        current_index = workspace.get_parent(current_index);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+}    // namespace
+
+template <typename GraphT, typename HeuristicT, typename CostT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput fringe_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                           const HeuristicT &heuristic, SearchContext &context) {
+    // Nodes in the fringe are the generated nodes which are not closed
+    SearchWorkspace<CostT> &workspace = context.get_workspace<CostT>();
+    workspace.reset(graph.num_nodes());
+    FringeOpenList<CostT> &fringe = workspace.template get_open<FringeOpenList<CostT>>();
+    fringe.reserve(graph.num_nodes());
+
+    // Init
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+
+    ThreadTimer timer;
+    timer.start();
+
+    workspace.generate(start_index, CostT{}, NO_PARENT);
+    fringe.push_front(start_index, heuristic(start_index));
+    CostT f_limit = fringe.get_f(start_index);
+    while (!fringe.empty()) {
+        // Smallest f-value over the limit seen in this sweep
+        bool found_next_limit = false;
+        CostT next_f_limit{};
+
+        std::size_t index = fringe.front();
+        while (index != FringeOpenList<CostT>::NONE) {
+            const CostT &f = fringe.get_f(index);
+            if (f_limit < f) {
+                if (!found_next_limit || f < next_f_limit) {
+                    next_f_limit = f;
+                    found_next_limit = true;
+                }
+                index = fringe.next(index);
+                continue;
+            }
+
+            // Goal check, the limit never exceeds the optimal cost so the path is optimal
+            const CostT g = workspace.get_g(index);
+            if (index == goal_index) {
+                double duration = timer.get_duration();
+                const SearchOutput search_output{expanded, generated, duration, duration, cost_to_double(g),
+                                                 reconstruct_path(graph, workspace, index), {}};
+#ifdef DEBUG
+                std::cout << "Solution found. Solution length: " << search_output.path_node_ids.size()
+                          << ", solution cost: " << search_output.path_cost << ", Expanded: " << expanded
+                          << ", Generated: " << generated << ", Time: " << duration << "s" << std::endl;
+#endif
+                return search_output;
+            }
+
+            // Children with a better path are moved right after the node, so this sweep visits them next
+            ++expanded;
+            graph.for_each_neighbour(index, [&](std::size_t child_index, const CostT &edge_cost) {
+                const CostT child_g = g + edge_cost;
+                if (workspace.is_generated(child_index)) {
+                    if (!(child_g < workspace.get_g(child_index))) {
+                        return;
+                    }
+                    if (!workspace.is_closed(child_index)) {
+                        fringe.remove(child_index);
+                    }
+                }
+                workspace.generate(child_index, child_g, index);
+                fringe.insert_after(index, child_index, child_g + heuristic(child_index));
+                ++generated;
+            });
+
+            const std::size_t next_index = fringe.next(index);
+            fringe.remove(index);
+            workspace.close(index);
+            index = next_index;
+        }
+
+        if (!found_next_limit) {
+            break;
+        }
+        f_limit = next_f_limit;
+    }
+#ifdef DEBUG
+    std::cerr << "Exhausted search space, no solution found" << std::endl;
+#endif
+    return {expanded, generated, timer.get_duration(), -1, -1, {}, {}};
+}
+
+template SearchOutput fringe_search<GridGraphView, GridOctileHeuristic, OctileCost>(const GridGraphView &,
+                                                                                    std::size_t, std::size_t,
+                                                                                    const GridOctileHeuristic &,
+                                                                                    SearchContext &);
+template SearchOutput fringe_search<AbstractGraphView, AbstractOctileHeuristic, double>(
+    const AbstractGraphView &, std::size_t, std::size_t, const AbstractOctileHeuristic &, SearchContext &);
+
+SearchOutput fringe(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                    SearchContext &context) {
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        return fringe_search(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), context);
+    }
+    const AbstractGraphView view(graph);
+    return fringe_search(view, start_index, goal_index, AbstractOctileHeuristic(view, goal_index), context);
+}
+
+}    // namespace tpl_search
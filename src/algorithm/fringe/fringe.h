@@ -0,0 +1,46 @@
+// File: fringe.h
+// Fringe search algorithm
+
+#ifndef PRA_ALGORITHM_FRINGE_H
+#define PRA_ALGORITHM_FRINGE_H
+
+#include "algorithm/common/graph.h"
+#include "algorithm/common/graph_view.h"
+#include "algorithm/common/search_concepts.h"
+#include "algorithm/common/search_context.h"
+#include "algorithm/common/search_output.h"
+
+namespace tpl_search {
+
+/**
+ * Perform Fringe search over dense node indices.
+ * Open nodes are kept in a single linked list which is swept in order with an f-limit. Nodes within the limit are
+ * expanded and their children inserted right after them so the same sweep visits them, nodes over the limit are left
+ * for a later sweep with the smallest f-value passed over as the next limit. No priority queue is kept at all.
+ * @note Only the grid and abstract graph views with their octile heuristics are instantiated in fringe.cpp
+ * @param graph The graph to search over
+ * @param start_index Dense index of the start node
+ * @param goal_index Dense index of the goal node
+ * @param heuristic Heuristic estimating the cost to the goal node, must be admissible
+ * @param context Search workspace to reuse
+ * @return Results of search
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput fringe_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                           const HeuristicT &heuristic, SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform Fringe search
+ * @param graph The graph to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search
+ */
+SearchOutput fringe(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                    SearchContext &context = get_thread_search_context());
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_FRINGE_H
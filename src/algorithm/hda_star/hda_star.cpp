@@ -0,0 +1,303 @@
+// File: hda_star.cpp
+// Hash distributed A* (HDA*) search algorithm
+
+#include "hda_star.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "util/mpsc_queue.h"
+#include "util/timer.h"
+
+namespace tpl_search {
+
+namespace {
+
+// Generated node sent to the thread owning it
+template <typename CostT>
+struct NodeMessage {
+    std::size_t index;
+    CostT g;
+    std::size_t parent_index;
+};
+
+// Nodes generated by one expansion are sent to each thread together
+template <typename CostT>
+using MessageBatch = std::vector<NodeMessage<CostT>>;
+
+/**
+ * Get the thread owning a node
+ * @param index Dense index of the node
+ * @param num_threads Number of threads searching
+ * @return Index of the owning thread
+ */
+std::size_t owner_thread(std::size_t index, std::size_t num_threads) {
+    // Fibonacci hashing, so neighbouring nodes are spread over the threads
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(index) * 0x9E3779B97F4A7C15ULL) >> 32) % num_threads;
+}
+
+// State shared between all threads of a search
+template <typename CostT>
+struct SharedSearch {
+    explicit SharedSearch(std::size_t num_threads)
+        : queues(num_threads), pending_work(static_cast<std::int64_t>(num_threads)) {}
+
+    std::vector<MPSCQueue<MessageBatch<CostT>>> queues;    // Incoming nodes of each thread
+    std::atomic<bool> found{false};                        // Set once best_cost holds a path
+    std::atomic<CostT> best_cost{};                        // Only written by the owner of the goal
+    // Number of threads with nodes left to expand plus the number of nodes in flight, the search is over once it
+    // reaches zero. It can only grow while it is not zero, as only working threads send nodes.
+    std::atomic<std::int64_t> pending_work;
+};
+
+// Search run by a single thread over the nodes it owns
+template <typename GraphT, typename HeuristicT, typename CostT>
+class HDAStarWorker {
+public:
+    using Node = SearchNode<CostT>;
+
+    HDAStarWorker(const GraphT &graph, const HeuristicT &heuristic, std::size_t goal_index, std::size_t thread_index,
+                  SharedSearch<CostT> &shared, SearchContext &context)
+        : graph(graph),
+          heuristic(heuristic),
+          goal_index(goal_index),
+          thread_index(thread_index),
+          shared(shared),
+          workspace(context.get_workspace<CostT>()),
+          open(workspace.template get_open<HeapOpenList<CostT>>()),
+          outboxes(shared.queues.size()) {
+        workspace.reset(graph.num_nodes());
+    }
+
+    /**
+     * Add a node owned by this thread, only to be called before the search starts
+     * @param message The node to add
+     */
+    void seed(const NodeMessage<CostT> &message) {
+        assert(owner_thread(message.index, shared.queues.size()) == thread_index);
+        relax(message);
+    }
+
+    /**
+     * Search until every thread has run out of nodes which can improve on the best path
+     */
+    void run() {
+        bool working = true;
+        MessageBatch<CostT> batch;
+        while (true) {
+            // Take in the nodes sent by other threads
+            while (shared.queues[thread_index].try_pop(batch)) {
+                if (!working) {
+                    shared.pending_work.fetch_add(1, std::memory_order_acq_rel);
+                    working = true;
+                }
+                for (const NodeMessage<CostT> &message : batch) {
+                    relax(message);
+                }
+                shared.pending_work.fetch_sub(static_cast<std::int64_t>(batch.size()), std::memory_order_acq_rel);
+            }
+
+            // Nodes which can't lead to a better path are dropped
+            while (!open.empty() && is_pruned(open.top().f)) {
+                workspace.close(open.pop().index);
+            }
+
+            if (open.empty()) {
+                if (working) {
+                    shared.pending_work.fetch_sub(1, std::memory_order_acq_rel);
+                    working = false;
+                }
+                if (shared.pending_work.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Nodes are sent straight away, holding them back lets the owner expand worse paths in the meantime
+            expand();
+            for (std::size_t owner = 0; owner < outboxes.size(); ++owner) {
+                flush(owner);
+            }
+        }
+    }
+
+    std::size_t get_expanded() const {
+        return expanded;
+    }
+
+    std::size_t get_generated() const {
+        return generated;
+    }
+
+private:
+    bool is_pruned(const CostT &f) const {
+        return shared.found.load(std::memory_order_acquire) &&
+               !(f < shared.best_cost.load(std::memory_order_relaxed));
+    }
+
+    // Expand the best node owned by this thread
+    void expand() {
+        const Node current = open.pop();
+        workspace.close(current.index);
+        ++expanded;
+
+        // Goal check, f-values below the best path are all that remain open so this path is better
+        if (current.index == goal_index) {
+            shared.best_cost.store(current.g, std::memory_order_relaxed);
+            shared.found.store(true, std::memory_order_release);
+            return;
+        }
+
+        graph.for_each_neighbour(current.index, [&](std::size_t neighbour_index, const CostT &edge_cost) {
+            const NodeMessage<CostT> message{neighbour_index, current.g + edge_cost, current.index};
+            const std::size_t owner = owner_thread(neighbour_index, outboxes.size());
+            if (owner == thread_index) {
+                relax(message);
+                return;
+            }
+            if (is_pruned(message.g + heuristic(neighbour_index))) {
+                return;
+            }
+            outboxes[owner].push_back(message);
+        });
+    }
+
+    // Update an owned node if the path in the message is better
+    void relax(const NodeMessage<CostT> &message) {
+        const std::size_t index = message.index;
+        const Node node{index, message.g, message.g + heuristic(index)};
+        // Paths which can't improve on the best path are never stored, so the parents along it stay valid
+        if (is_pruned(node.f) || (workspace.is_generated(index) && !(node.g < workspace.get_g(index)))) {
+            return;
+        }
+        // Generated nodes are either open or closed, closed nodes are reopened with the better path
+        const bool was_open = workspace.is_generated(index) && !workspace.is_closed(index);
+        workspace.generate(index, node.g, message.parent_index);
+        if (was_open) {
+            open.decrease(node);
+        } else {
+            open.push(node);
+        }
+        ++generated;
+    }
+
+    // Send the pending nodes of another thread
+    void flush(std::size_t owner) {
+        if (outboxes[owner].empty()) {
+            return;
+        }
+        shared.pending_work.fetch_add(static_cast<std::int64_t>(outboxes[owner].size()), std::memory_order_acq_rel);
+        shared.queues[owner].push(std::move(outboxes[owner]));
+        outboxes[owner] = MessageBatch<CostT>();
+    }
+
+    const GraphT &graph;
+    const HeuristicT &heuristic;
+    std::size_t goal_index;
+    std::size_t thread_index;
+    SharedSearch<CostT> &shared;
+    SearchWorkspace<CostT> &workspace;
+    HeapOpenList<CostT> &open;
+    std::vector<MessageBatch<CostT>> outboxes;    // Nodes waiting to be sent to each thread
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+};
+
+}    // namespace
+
+template <typename GraphT, typename HeuristicT, typename CostT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput hda_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                             const HeuristicT &heuristic, std::size_t num_threads,
+                             std::vector<SearchContext> &contexts) {
+    using Worker = HDAStarWorker<GraphT, HeuristicT, CostT>;
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    if (contexts.size() < num_threads) {
+        contexts.resize(num_threads);
+    }
+
+    // Init
+    WallTimer timer;
+    timer.start();
+
+    SharedSearch<CostT> shared(num_threads);
+    std::vector<Worker> workers;
+    workers.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        workers.emplace_back(graph, heuristic, goal_index, i, shared, contexts[i]);
+    }
+    workers[owner_thread(start_index, num_threads)].seed({start_index, CostT{}, NO_PARENT});
+
+    // The calling thread searches as the first worker
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(&Worker::run, &workers[i]);
+    }
+    workers[0].run();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+    for (const Worker &worker : workers) {
+        expanded += worker.get_expanded();
+        generated += worker.get_generated();
+    }
+
+    if (!shared.found.load()) {
+#ifdef DEBUG
+        std::cerr << "Exhausted search space, no solution found" << std::endl;
+#endif
+        return {expanded, generated, timer.get_duration(), -1, -1, {}, {}};
+    }
+
+    // Each parent is held by the thread owning the node
+    std::vector<std::size_t> path;
+    for (std::size_t index = goal_index; index != NO_PARENT;
+         index = contexts[owner_thread(index, num_threads)].get_workspace<CostT>().get_parent(index)) {
+        path.push_back(graph.get_node_id(index));
+    }
+    std::reverse(path.begin(), path.end());
+    assert(path.front() == graph.get_node_id(start_index));
+
+    double duration = timer.get_duration();
+    const SearchOutput search_output{
+        expanded, generated, duration, duration, cost_to_double(shared.best_cost.load()), path, {}};
+#ifdef DEBUG
+    std::cout << "Solution found. Solution length: " << search_output.path_node_ids.size()
+              << ", solution cost: " << search_output.path_cost << ", Expanded: " << expanded
+              << ", Generated: " << generated << ", Time: " << duration << "s" << std::endl;
+#endif
+    return search_output;
+}
+
+template SearchOutput hda_star_search<GridGraphView, GridOctileHeuristic, OctileCost>(
+    const GridGraphView &, std::size_t, std::size_t, const GridOctileHeuristic &, std::size_t,
+    std::vector<SearchContext> &);
+template SearchOutput hda_star_search<AbstractGraphView, AbstractOctileHeuristic, double>(
+    const AbstractGraphView &, std::size_t, std::size_t, const AbstractOctileHeuristic &, std::size_t,
+    std::vector<SearchContext> &);
+
+SearchOutput hda_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                      std::size_t num_threads, std::vector<SearchContext> &contexts) {
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        return hda_star_search(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), num_threads,
+                               contexts);
+    }
+    const AbstractGraphView view(graph);
+    return hda_star_search(view, start_index, goal_index, AbstractOctileHeuristic(view, goal_index), num_threads,
+                           contexts);
+}
+
+}    // namespace tpl_search
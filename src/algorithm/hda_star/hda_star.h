@@ -0,0 +1,51 @@
+// File: hda_star.h
+// Hash distributed A* (HDA*) search algorithm
+
+#ifndef PRA_ALGORITHM_HDA_STAR_H
+#define PRA_ALGORITHM_HDA_STAR_H
+
+#include <vector>
+
+#include "algorithm/common/graph.h"
+#include "algorithm/common/graph_view.h"
+#include "algorithm/common/search_concepts.h"
+#include "algorithm/common/search_context.h"
+#include "algorithm/common/search_output.h"
+
+namespace tpl_search {
+
+/**
+ * Perform HDA* search over dense node indices.
+ * Each node is owned by the thread its index hashes to, which keeps its g-value and open list entry. Generated nodes
+ * are sent to their owner through lock-free queues. The search ends once no thread has a node with an f-value below
+ * the best path found and no nodes are in flight, so the path is optimal.
+ * @note Only the grid and abstract graph views with their octile heuristics are instantiated in hda_star.cpp
+ * @param graph The graph to search over
+ * @param start_index Dense index of the start node
+ * @param goal_index Dense index of the goal node
+ * @param heuristic Heuristic estimating the cost to the goal node, must be consistent and safe to share between threads
+ * @param num_threads Number of threads to search with, 1 searches on the calling thread
+ * @param contexts Search workspaces to reuse, one per thread, resized as needed
+ * @return Results of search, the durations are wall clock time
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput hda_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                             const HeuristicT &heuristic, std::size_t num_threads,
+                             std::vector<SearchContext> &contexts);
+
+/**
+ * Perform HDA* search
+ * @param graph The graph to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param num_threads Number of threads to search with
+ * @param contexts Search workspaces to reuse, one per thread, resized as needed
+ * @return Results of search
+ */
+SearchOutput hda_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                      std::size_t num_threads, std::vector<SearchContext> &contexts);
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_HDA_STAR_H
@@ -0,0 +1,396 @@
+// File: jps.cpp
+// Jump Point Search algorithm
+
+#include "jps.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+#include "algorithm/common/octile_cost.h"
+#include "algorithm/common/search_concepts.h"
+#include "util/timer.h"
+
+namespace tpl_search {
+
+namespace {
+
+constexpr std::ptrdiff_t NO_JUMP = std::numeric_limits<std::ptrdiff_t>::min();
+
+/**
+ * Scan a line of cells in the increasing direction for the first jump point, 64 cells at a time.
+ * A cell is a jump point if it is the target, or if a side cell is pathable while the side cell behind it is not.
+ * @param read Reads 64 bits of a line starting at a position
+ * @param line The line being scanned, its sides are line - 1 and line + 1
+ * @param pos The first position to test
+ * @param target Position on this line which is a jump point, NO_JUMP if none
+ * @return The position of the jump point, NO_JUMP if a blocked cell is reached first
+ */
+template <typename ReadT>
+std::ptrdiff_t scan_increasing(const ReadT &read, std::ptrdiff_t line, std::ptrdiff_t pos, std::ptrdiff_t target) {
+    while (true) {
+        const std::uint64_t free = read(line, pos);
+        const std::uint64_t forced =
+            (read(line - 1, pos) & ~read(line - 1, pos - 1)) | (read(line + 1, pos) & ~read(line + 1, pos - 1));
+        std::uint64_t stop = ~free | forced;
+        if (target >= pos && target < pos + 64) {
+            stop |= std::uint64_t{1} << (target - pos);
+        }
+        if (stop != 0) {
+            const int bit = std::countr_zero(stop);
+            return ((free >> bit) & 1) != 0 ? pos + bit : NO_JUMP;
+        }
+        pos += 64;
+    }
+}
+
+/**
+ * Scan a line of cells in the decreasing direction for the first jump point, 64 cells at a time
+ * @param read Reads 64 bits of a line starting at a position
+ * @param line The line being scanned, its sides are line - 1 and line + 1
+ * @param pos The first position to test
+ * @param target Position on this line which is a jump point, NO_JUMP if none
+ * @return The position of the jump point, NO_JUMP if a blocked cell is reached first
+ */
+template <typename ReadT>
+std::ptrdiff_t scan_decreasing(const ReadT &read, std::ptrdiff_t line, std::ptrdiff_t pos, std::ptrdiff_t target) {
+    while (true) {
+        // Bit 63 is the current position
+        const std::ptrdiff_t base = pos - 63;
+        const std::uint64_t free = read(line, base);
+        const std::uint64_t forced =
+            (read(line - 1, base) & ~read(line - 1, base + 1)) | (read(line + 1, base) & ~read(line + 1, base + 1));
+        std::uint64_t stop = ~free | forced;
+        if (target >= base && target <= pos) {
+            stop |= std::uint64_t{1} << (target - base);
+        }
+        if (stop != 0) {
+            const int bit = 63 - std::countl_zero(stop);
+            return ((free >> bit) & 1) != 0 ? base + bit : NO_JUMP;
+        }
+        pos -= 64;
+    }
+}
+
+// Jumps over the grid towards a fixed goal
+class Jumper {
+public:
+    Jumper(const BitGrid &grid, const GridPosition &goal_pos)
+        : grid(grid),
+          goal_x(static_cast<std::ptrdiff_t>(goal_pos.x)),
+          goal_y(static_cast<std::ptrdiff_t>(goal_pos.y)) {}
+
+    /**
+     * Jump along a row, starting with the cell (x, y)
+     * @return Column of the jump point, NO_JUMP if there is none
+     */
+    std::ptrdiff_t jump_horizontal(std::ptrdiff_t x, std::ptrdiff_t y, std::ptrdiff_t dx) const {
+        const auto read = [this](std::ptrdiff_t row, std::ptrdiff_t column) { return grid.row_bits(row, column); };
+        const std::ptrdiff_t target = y == goal_y ? goal_x : NO_JUMP;
+        return dx > 0 ? scan_increasing(read, y, x, target) : scan_decreasing(read, y, x, target);
+    }
+
+    /**
+     * Jump along a column, starting with the cell (x, y)
+     * @return Row of the jump point, NO_JUMP if there is none
+     */
+    std::ptrdiff_t jump_vertical(std::ptrdiff_t x, std::ptrdiff_t y, std::ptrdiff_t dy) const {
+        const auto read = [this](std::ptrdiff_t column, std::ptrdiff_t row) { return grid.column_bits(column, row); };
+        const std::ptrdiff_t target = x == goal_x ? goal_y : NO_JUMP;
+        return dy > 0 ? scan_increasing(read, x, y, target) : scan_decreasing(read, x, y, target);
+    }
+
+    /**
+     * Jump diagonally, starting with the cell (x, y). A cell is a jump point if a straight jump along either
+     * component of the direction finds one.
+     * @return True if a jump point was found, which is placed in (x, y)
+     */
+    bool jump_diagonal(std::ptrdiff_t &x, std::ptrdiff_t &y, std::ptrdiff_t dx, std::ptrdiff_t dy) const {
+        while (grid.is_free(x, y)) {
+            if ((x == goal_x && y == goal_y) || jump_horizontal(x + dx, y, dx) != NO_JUMP ||
+                jump_vertical(x, y + dy, dy) != NO_JUMP) {
+                return true;
+            }
+            // No corner cutting
+            if (!grid.is_free(x + dx, y) || !grid.is_free(x, y + dy)) {
+                return false;
+            }
+            x += dx;
+            y += dy;
+        }
+        return false;
+    }
+
+    /**
+     * Jump from a cell in the given direction
+     * @return True if a jump point was found, which is placed in (x, y)
+     */
+    bool jump(std::ptrdiff_t &x, std::ptrdiff_t &y, std::ptrdiff_t dx, std::ptrdiff_t dy) const {
+        if (dx != 0 && dy != 0) {
+            x += dx;
+            y += dy;
+            return jump_diagonal(x, y, dx, dy);
+        }
+        if (dx != 0) {
+            x = jump_horizontal(x + dx, y, dx);
+            return x != NO_JUMP;
+        }
+        y = jump_vertical(x, y + dy, dy);
+        return y != NO_JUMP;
+    }
+
+private:
+    const BitGrid &grid;
+    std::ptrdiff_t goal_x;
+    std::ptrdiff_t goal_y;
+};
+
+// Jumps towards a fixed goal by looking up precomputed jump distances.
+// A straight jump stops at the goal if it lies ahead before the next jump point or wall. A diagonal jump towards the
+// goal stops where it reaches the goal's row or column, from which a straight jump can reach the goal.
+class TableJumper {
+public:
+    TableJumper(const JumpTable &jump_table, const GridPosition &goal_pos)
+        : jump_table(jump_table),
+          goal_x(static_cast<std::ptrdiff_t>(goal_pos.x)),
+          goal_y(static_cast<std::ptrdiff_t>(goal_pos.y)) {}
+
+    /**
+     * Jump from a cell in the given direction
+     * @return True if a jump point was found, which is placed in (x, y)
+     */
+    bool jump(std::ptrdiff_t &x, std::ptrdiff_t &y, std::ptrdiff_t dx, std::ptrdiff_t dy) const {
+        const std::int16_t distance = jump_table.get_distance(static_cast<std::size_t>(x), static_cast<std::size_t>(y),
+                                                              to_jump_direction(dx, dy));
+        const std::ptrdiff_t reach = distance > 0 ? distance : -distance;
+        const std::ptrdiff_t goal_dx = goal_x - x;
+        const std::ptrdiff_t goal_dy = goal_y - y;
+
+        // Steps to the goal, or to its row or column for diagonal jumps, zero if it isn't ahead
+        std::ptrdiff_t goal_steps = 0;
+        if (dx != 0 && dy != 0) {
+            if (goal_dx * dx > 0 && goal_dy * dy > 0) {
+                goal_steps = std::min(goal_dx * dx, goal_dy * dy);
+            }
+        } else if (goal_dx * dy == 0 && goal_dy * dx == 0 && goal_dx * dx + goal_dy * dy > 0) {
+            goal_steps = goal_dx * dx + goal_dy * dy;
+        }
+
+        const std::ptrdiff_t steps = goal_steps > 0 && goal_steps <= reach ? goal_steps : distance;
+        if (steps <= 0) {
+            return false;
+        }
+        x += steps * dx;
+        y += steps * dy;
+        return true;
+    }
+
+private:
+    const JumpTable &jump_table;
+    std::ptrdiff_t goal_x;
+    std::ptrdiff_t goal_y;
+};
+
+// Direction of a move, as the sign of each component
+struct Move {
+    std::ptrdiff_t dx;
+    std::ptrdiff_t dy;
+};
+
+std::ptrdiff_t sign(std::ptrdiff_t v) {
+    return (v > 0) - (v < 0);
+}
+
+/**
+ * Get the directions to jump in from a cell after pruning, or every legal direction for the start cell
+ * @param grid The grid being searched
+ * @param x Column of the cell
+ * @param y Row of the cell
+ * @param move Direction the cell was reached in, zero for the start cell
+ * @param moves Storage to place the directions in
+ */
+void successor_moves(const BitGrid &grid, std::ptrdiff_t x, std::ptrdiff_t y, const Move &move,
+                     std::vector<Move> &moves) {
+    moves.clear();
+    const auto free = [&](std::ptrdiff_t dx, std::ptrdiff_t dy) { return grid.is_free(x + dx, y + dy); };
+    const std::ptrdiff_t dx = move.dx;
+    const std::ptrdiff_t dy = move.dy;
+    if (dx == 0 && dy == 0) {
+        for (const std::ptrdiff_t ndy : {-1, 0, 1}) {
+            for (const std::ptrdiff_t ndx : {-1, 0, 1}) {
+                if ((ndx != 0 || ndy != 0) && free(ndx, 0) && free(0, ndy) && free(ndx, ndy)) {
+                    moves.push_back({ndx, ndy});
+                }
+            }
+        }
+    } else if (dx != 0 && dy != 0) {
+        moves.push_back({0, dy});
+        moves.push_back({dx, 0});
+        if (free(dx, 0) && free(0, dy)) {
+            moves.push_back({dx, dy});
+        }
+    } else if (dx != 0) {
+        const bool next = free(dx, 0);
+        const bool up = free(0, -1);
+        const bool down = free(0, 1);
+        if (next) {
+            moves.push_back({dx, 0});
+            if (up) {
+                moves.push_back({dx, -1});
+            }
+            if (down) {
+                moves.push_back({dx, 1});
+            }
+        }
+        if (up) {
+            moves.push_back({0, -1});
+        }
+        if (down) {
+            moves.push_back({0, 1});
+        }
+    } else {
+        const bool next = free(0, dy);
+        const bool left = free(-1, 0);
+        const bool right = free(1, 0);
+        if (next) {
+            moves.push_back({0, dy});
+            if (left) {
+                moves.push_back({-1, dy});
+            }
+            if (right) {
+                moves.push_back({1, dy});
+            }
+        }
+        if (left) {
+            moves.push_back({-1, 0});
+        }
+        if (right) {
+            moves.push_back({1, 0});
+        }
+    }
+}
+
+/**
+ * Perform Jump Point Search with the given jumps
+ * @param grid The grid to search over
+ * @param jumper Finds the next jump point from a cell in a direction towards the goal
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse
+ * @return Results of search
+ */
+template <typename JumperT>
+SearchOutput jump_point_search(const BitGrid &grid, const JumperT &jumper, const GridPosition &start_pos,
+                               const GridPosition &goal_pos, SearchContext &context) {
+    using Node = SearchNode<OctileCost>;
+    assert(grid.is_free(static_cast<std::ptrdiff_t>(start_pos.x), static_cast<std::ptrdiff_t>(start_pos.y)));
+    assert(grid.is_free(static_cast<std::ptrdiff_t>(goal_pos.x), static_cast<std::ptrdiff_t>(goal_pos.y)));
+    const std::size_t width = grid.get_width();
+    const auto to_position = [width](std::size_t index) -> GridPosition { return {index % width, index / width}; };
+
+    // Nodes are indexed by cell ID
+    SearchWorkspace<OctileCost> &workspace = context.get_workspace<OctileCost>();
+    workspace.reset(width * grid.get_height());
+    HeapOpenList<OctileCost> &open = workspace.get_open<HeapOpenList<OctileCost>>();
+    std::vector<Move> moves;
+
+    // Init
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+
+    ThreadTimer timer;
+    timer.start();
+
+    const std::size_t start_index = start_pos.y * width + start_pos.x;
+    const std::size_t goal_index = goal_pos.y * width + goal_pos.x;
+    workspace.generate(start_index, OctileCost{}, NO_PARENT);
+    open.push({start_index, OctileCost{}, octile_distance(start_pos, goal_pos)});
+    while (!open.empty()) {
+        const Node current = open.pop();
+        workspace.close(current.index);
+        ++expanded;
+
+        // Goal check
+        if (current.index == goal_index) {
+            // Fill in the cells between jump points, which lie on straight lines
+            std::vector<std::size_t> path{goal_index};
+            for (std::size_t index = goal_index; workspace.get_parent(index) != NO_PARENT;
+                 index = workspace.get_parent(index)) {
+                const GridPosition to = to_position(index);
+                const GridPosition from = to_position(workspace.get_parent(index));
+                const std::ptrdiff_t dx = sign(static_cast<std::ptrdiff_t>(from.x) - static_cast<std::ptrdiff_t>(to.x));
+                const std::ptrdiff_t dy = sign(static_cast<std::ptrdiff_t>(from.y) - static_cast<std::ptrdiff_t>(to.y));
+                const std::ptrdiff_t step = dy * static_cast<std::ptrdiff_t>(width) + dx;
+                for (std::size_t cell = index; cell != workspace.get_parent(index);) {
+                    cell = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(cell) + step);
+                    path.push_back(cell);
+                }
+            }
+            std::reverse(path.begin(), path.end());
+
+            double duration = timer.get_duration();
+            const SearchOutput search_output{expanded, generated, duration, duration, cost_to_double(current.g),
+                                             path, {}};
+#ifdef DEBUG
+            std::cout << "Solution found. Solution length: " << search_output.path_node_ids.size()
+                      << ", solution cost: " << search_output.path_cost << ", Expanded: " << expanded
+                      << ", Generated: " << generated << ", Time: " << duration << "s" << std::endl;
+#endif
+            return search_output;
+        }
+
+        // Jump in each direction left after pruning
+        const GridPosition position = to_position(current.index);
+        const auto x = static_cast<std::ptrdiff_t>(position.x);
+        const auto y = static_cast<std::ptrdiff_t>(position.y);
+        Move move{0, 0};
+        if (workspace.get_parent(current.index) != NO_PARENT) {
+            const GridPosition parent = to_position(workspace.get_parent(current.index));
+            move = {sign(x - static_cast<std::ptrdiff_t>(parent.x)), sign(y - static_cast<std::ptrdiff_t>(parent.y))};
+        }
+        successor_moves(grid, x, y, move, moves);
+        for (const Move &successor_move : moves) {
+            std::ptrdiff_t jump_x = x;
+            std::ptrdiff_t jump_y = y;
+            if (!jumper.jump(jump_x, jump_y, successor_move.dx, successor_move.dy)) {
+                continue;
+            }
+            const GridPosition jump_pos{static_cast<std::size_t>(jump_x), static_cast<std::size_t>(jump_y)};
+            const std::size_t child_index = jump_pos.y * width + jump_pos.x;
+            const OctileCost child_g = current.g + octile_distance(position, jump_pos);
+            if (workspace.is_generated(child_index) && !(child_g < workspace.get_g(child_index))) {
+                continue;
+            }
+            const bool was_open = workspace.is_generated(child_index) && !workspace.is_closed(child_index);
+            workspace.generate(child_index, child_g, current.index);
+            const Node child_node{child_index, child_g, child_g + octile_distance(jump_pos, goal_pos)};
+            if (was_open) {
+                open.decrease(child_node);
+            } else {
+                open.push(child_node);
+            }
+            ++generated;
+        }
+    }
+#ifdef DEBUG
+    std::cerr << "Exhausted search space, no solution found" << std::endl;
+#endif
+    return {expanded, generated, timer.get_duration(), -1, -1, {}, {}};
+}
+
+}    // namespace
+
+SearchOutput jps(const BitGrid &grid, const GridPosition &start_pos, const GridPosition &goal_pos,
+                 SearchContext &context) {
+    return jump_point_search(grid, Jumper(grid, goal_pos), start_pos, goal_pos, context);
+}
+
+SearchOutput jps_plus(const BitGrid &grid, const JumpTable &jump_table, const GridPosition &start_pos,
+                      const GridPosition &goal_pos, SearchContext &context) {
+    assert(jump_table.get_width() == grid.get_width() && jump_table.get_height() == grid.get_height());
+    return jump_point_search(grid, TableJumper(jump_table, goal_pos), start_pos, goal_pos, context);
+}
+
+}    // namespace tpl_search
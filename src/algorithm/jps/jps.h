@@ -0,0 +1,43 @@
+// File: jps.h
+// Jump Point Search algorithm
+
+#ifndef PRA_ALGORITHM_JPS_H
+#define PRA_ALGORITHM_JPS_H
+
+#include "algorithm/common/graph.h"
+#include "algorithm/common/search_context.h"
+#include "algorithm/common/search_output.h"
+#include "algorithm/jps/jump_table.h"
+#include "util/bit_grid.h"
+
+namespace tpl_search {
+
+/**
+ * Perform Jump Point Search on an 8-connected grid where diagonal moves require both adjacent cardinal cells to be
+ * pathable, matching the layer 0 graph built by load_flat_graph.
+ * Straight jumps scan 64 cells at a time using the row and column bits of the grid.
+ * @param grid The grid to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search, the path is given as the IDs y * width + x of every cell along it
+ */
+SearchOutput jps(const BitGrid &grid, const GridPosition &start_pos, const GridPosition &goal_pos,
+                 SearchContext &context = get_thread_search_context());
+
+/**
+ * Perform JPS+, Jump Point Search where jumps are looked up in a precomputed jump table instead of scanned.
+ * Expands the same jump points as jps, plus the cells where a diagonal jump reaches the goal's row or column.
+ * @param grid The grid to search over
+ * @param jump_table Jump table built from the same grid
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param context Search workspace to reuse, defaults to the one owned by the calling thread
+ * @return Results of search, the path is given as the IDs y * width + x of every cell along it
+ */
+SearchOutput jps_plus(const BitGrid &grid, const JumpTable &jump_table, const GridPosition &start_pos,
+                      const GridPosition &goal_pos, SearchContext &context = get_thread_search_context());
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_JPS_H
@@ -0,0 +1,187 @@
+// File: jump_table.cpp
+// Precomputed jump distances for JPS+
+
+#include "jump_table.h"
+
+#include <nop/serializer.h>
+#include <nop/utility/stream_reader.h>
+#include <nop/utility/stream_writer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "util/file_util.h"
+#include "util/map.h"
+
+namespace tpl_search {
+
+namespace {
+
+/**
+ * Run independent tasks over a pool of threads
+ * @param num_tasks Number of tasks, each is run once
+ * @param num_threads Maximum number of threads to use, the calling thread is used if 1
+ * @param task Function called with the index of the task to run
+ */
+template <typename TaskT>
+void run_parallel(std::size_t num_tasks, std::size_t num_threads, const TaskT &task) {
+    num_threads = std::clamp<std::size_t>(num_threads, 1, std::max<std::size_t>(num_tasks, 1));
+    std::atomic<std::size_t> next_task{0};
+    const auto worker = [&]() {
+        for (std::size_t i = next_task++; i < num_tasks; i = next_task++) {
+            task(i);
+        }
+    };
+    if (num_threads == 1) {
+        worker();
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+// Extend the distance of the next cell by one step
+std::int16_t step_back(std::int16_t next_distance) {
+    return static_cast<std::int16_t>(next_distance > 0 ? next_distance + 1 : next_distance - 1);
+}
+
+}    // namespace
+
+JumpTable::JumpTable(const BitGrid &grid, std::size_t num_threads)
+    : width(grid.get_width()),
+      height(grid.get_height()),
+      distances(grid.get_width() * grid.get_height() * NUM_JUMP_DIRECTIONS, 0) {
+    if (width > std::numeric_limits<std::int16_t>::max() || height > std::numeric_limits<std::int16_t>::max()) {
+        std::cerr << "Error: map of size " << width << "x" << height << " is too large for a jump table" << std::endl;
+        exit(1);
+    }
+
+    // Straight directions are independent between lines, split each direction into chunks of lines
+    const std::size_t num_chunks = std::max<std::size_t>(num_threads, 1);
+    run_parallel(4 * num_chunks, num_threads, [&](std::size_t task) {
+        const auto direction = static_cast<JumpDirection>(task / num_chunks);
+        const std::size_t num_lines = JUMP_DY[direction] == 0 ? height : width;
+        const std::size_t chunk = task % num_chunks;
+        build_straight(grid, direction, num_lines * chunk / num_chunks, num_lines * (chunk + 1) / num_chunks);
+    });
+
+    // Each diagonal direction sweeps the whole grid on its own
+    run_parallel(4, num_threads, [&](std::size_t task) {
+        build_diagonal(grid, static_cast<JumpDirection>(SOUTH_EAST + task));
+    });
+}
+
+void JumpTable::build_straight(const BitGrid &grid, JumpDirection direction, std::size_t first_line,
+                               std::size_t last_line) {
+    const std::ptrdiff_t dx = JUMP_DX[direction];
+    const std::ptrdiff_t dy = JUMP_DY[direction];
+    // Side cells are perpendicular to the direction
+    const std::ptrdiff_t side_x = dy != 0 ? 1 : 0;
+    const std::ptrdiff_t side_y = dx != 0 ? 1 : 0;
+    const std::size_t line_length = dx != 0 ? width : height;
+    const bool increasing = dx + dy > 0;
+
+    for (std::size_t line = first_line; line < last_line; ++line) {
+        // Sweep against the direction, so the next cell is always done
+        for (std::size_t step = 0; step < line_length; ++step) {
+            const std::size_t pos = increasing ? line_length - 1 - step : step;
+            const std::size_t x = dx != 0 ? pos : line;
+            const std::size_t y = dx != 0 ? line : pos;
+            const std::ptrdiff_t next_x = static_cast<std::ptrdiff_t>(x) + dx;
+            const std::ptrdiff_t next_y = static_cast<std::ptrdiff_t>(y) + dy;
+            if (!grid.is_free(next_x, next_y)) {
+                at(x, y, direction) = 0;
+                continue;
+            }
+            bool forced = false;
+            for (const std::ptrdiff_t side : {-1, 1}) {
+                const std::ptrdiff_t forced_x = next_x + side * side_x;
+                const std::ptrdiff_t forced_y = next_y + side * side_y;
+                forced |= grid.is_free(forced_x, forced_y) && !grid.is_free(forced_x - dx, forced_y - dy);
+            }
+            at(x, y, direction) =
+                forced ? 1
+                       : step_back(get_distance(static_cast<std::size_t>(next_x), static_cast<std::size_t>(next_y),
+                                                direction));
+        }
+    }
+}
+
+void JumpTable::build_diagonal(const BitGrid &grid, JumpDirection direction) {
+    const std::ptrdiff_t dx = JUMP_DX[direction];
+    const std::ptrdiff_t dy = JUMP_DY[direction];
+    const JumpDirection horizontal = to_jump_direction(dx, 0);
+    const JumpDirection vertical = to_jump_direction(0, dy);
+
+    // Sweep against the direction, so the next cell is always done
+    for (std::size_t row = 0; row < height; ++row) {
+        const std::size_t y = dy > 0 ? height - 1 - row : row;
+        for (std::size_t column = 0; column < width; ++column) {
+            const std::size_t x = dx > 0 ? width - 1 - column : column;
+            const auto cell_x = static_cast<std::ptrdiff_t>(x);
+            const auto cell_y = static_cast<std::ptrdiff_t>(y);
+            // No corner cutting
+            if (!grid.is_free(cell_x + dx, cell_y) || !grid.is_free(cell_x, cell_y + dy) ||
+                !grid.is_free(cell_x + dx, cell_y + dy)) {
+                at(x, y, direction) = 0;
+                continue;
+            }
+            const auto next_x = static_cast<std::size_t>(cell_x + dx);
+            const auto next_y = static_cast<std::size_t>(cell_y + dy);
+            const bool jump_point =
+                get_distance(next_x, next_y, horizontal) > 0 || get_distance(next_x, next_y, vertical) > 0;
+            at(x, y, direction) = jump_point ? 1 : step_back(get_distance(next_x, next_y, direction));
+        }
+    }
+}
+
+void JumpTable::save(const std::string &path) const {
+    if (!std::filesystem::exists(std::filesystem::path(path).parent_path())) {
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    }
+    std::filesystem::remove(path);
+    std::cout << "Exporting JumpTable to " << path << std::endl;
+    nop::Serializer<nop::StreamWriter<std::ofstream>> serializer{path};
+
+    serializer.Write(this->width);
+    serializer.Write(this->height);
+    serializer.Write(this->distances);
+}
+
+void JumpTable::load(const std::string &path) {
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "Error: " << path << " does not exist." << std::endl;
+        exit(1);
+    }
+    std::cout << "Loading JumpTable from " << path << std::endl;
+    nop::Deserializer<nop::StreamReader<std::ifstream>> deserializer{path};
+
+    deserializer.Read(&(this->width));
+    deserializer.Read(&(this->height));
+    deserializer.Read(&(this->distances));
+}
+
+JumpTable load_jump_table(const std::string &map_path, bool force_create, std::size_t num_threads) {
+    // Check if jump table is already cached
+    std::filesystem::path jump_table_path = map_to_jump_table_path(map_path);
+    JumpTable jump_table;
+    if (std::filesystem::exists(jump_table_path) && !force_create) {
+        jump_table.load(jump_table_path);
+        return jump_table;
+    }
+
+    // Otherwise we need to parse and create
+    return JumpTable(BitGrid(load_map(map_path)), num_threads);
+}
+
+}    // namespace tpl_search
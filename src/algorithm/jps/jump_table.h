@@ -0,0 +1,129 @@
+// File: jump_table.h
+// Precomputed jump distances for JPS+
+
+#ifndef PRA_ALGORITHM_JPS_JUMP_TABLE_H
+#define PRA_ALGORITHM_JPS_JUMP_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/bit_grid.h"
+
+namespace tpl_search {
+
+// Directions of the jump table, cardinal directions first
+enum JumpDirection {
+    EAST = 0,
+    WEST = 1,
+    SOUTH = 2,
+    NORTH = 3,
+    SOUTH_EAST = 4,
+    SOUTH_WEST = 5,
+    NORTH_EAST = 6,
+    NORTH_WEST = 7,
+    NUM_JUMP_DIRECTIONS = 8,
+};
+
+constexpr std::array<std::ptrdiff_t, NUM_JUMP_DIRECTIONS> JUMP_DX{1, -1, 0, 0, 1, -1, 1, -1};
+constexpr std::array<std::ptrdiff_t, NUM_JUMP_DIRECTIONS> JUMP_DY{0, 0, 1, -1, 1, 1, -1, -1};
+
+/**
+ * Get the jump table direction of a move
+ * @param dx Horizontal component of the move, -1, 0 or 1
+ * @param dy Vertical component of the move, -1, 0 or 1, not both zero
+ * @return The direction of the move
+ */
+constexpr JumpDirection to_jump_direction(std::ptrdiff_t dx, std::ptrdiff_t dy) {
+    if (dy == 0) {
+        return dx > 0 ? EAST : WEST;
+    }
+    if (dx == 0) {
+        return dy > 0 ? SOUTH : NORTH;
+    }
+    if (dy > 0) {
+        return dx > 0 ? SOUTH_EAST : SOUTH_WEST;
+    }
+    return dx > 0 ? NORTH_EAST : NORTH_WEST;
+}
+
+// For every cell and direction, the number of steps to the next jump point, or to the last cell before a wall.
+// Jump points follow the online jumps of jps, without a goal: a cell is a jump point of a straight move if it has a
+// forced neighbour, and of a diagonal move if a straight jump along either component of the move finds one.
+// Distances are stored as a positive number of steps to a jump point, or as zero or the negated number of steps that
+// can be taken before a wall if there is no jump point in that direction.
+class JumpTable {
+public:
+    JumpTable() = default;
+
+    /**
+     * Build the table for a grid
+     * @param grid The grid to precompute
+     * @param num_threads Number of threads to build with
+     */
+    explicit JumpTable(const BitGrid &grid, std::size_t num_threads = std::thread::hardware_concurrency());
+
+    std::size_t get_width() const {
+        return width;
+    }
+
+    std::size_t get_height() const {
+        return height;
+    }
+
+    /**
+     * Get the jump distance from a cell
+     * @param x Column of the cell
+     * @param y Row of the cell
+     * @param direction Direction to jump in
+     * @return Steps to the next jump point if positive, otherwise the negated steps to the last cell before a wall
+     */
+    std::int16_t get_distance(std::size_t x, std::size_t y, JumpDirection direction) const {
+        return distances[(y * width + x) * NUM_JUMP_DIRECTIONS + direction];
+    }
+
+    /**
+     * Save the table to the given path
+     * @param path Path to serialize the table
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * Load the table from a given path
+     * @param path Path to load the table from
+     */
+    void load(const std::string &path);
+
+private:
+    std::int16_t &at(std::size_t x, std::size_t y, JumpDirection direction) {
+        return distances[(y * width + x) * NUM_JUMP_DIRECTIONS + direction];
+    }
+
+    // Fill a straight direction along the given rows or columns
+    void build_straight(const BitGrid &grid, JumpDirection direction, std::size_t first_line, std::size_t last_line);
+
+    // Fill a diagonal direction over the whole grid, needs both of its straight directions
+    void build_diagonal(const BitGrid &grid, JumpDirection direction);
+
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::vector<std::int16_t> distances;    // Cell major, NUM_JUMP_DIRECTIONS per cell
+};
+
+/**
+ * Load the jump table for a map path
+ * @note If result hasn't been cached to disk, will be created on the fly
+ * @param map_path Path to map file
+ * @param force_create Force create the table even if it already exists on disk
+ * @param num_threads Number of threads to build with if it is created
+ * @return Jump table of the map
+ */
+JumpTable load_jump_table(const std::string &map_path, bool force_create = false,
+                          std::size_t num_threads = std::thread::hardware_concurrency());
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_JPS_JUMP_TABLE_H
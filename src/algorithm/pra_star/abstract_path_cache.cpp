@@ -0,0 +1,95 @@
+// File: abstract_path_cache.cpp
+// Cache of abstract paths shared between PRA* queries
+
+#include "abstract_path_cache.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace tpl_search {
+
+AbstractPathCache::AbstractPathCache(std::size_t capacity) : capacity(std::max<std::size_t>(capacity, 1)) {
+    entry_map.reserve(this->capacity);
+}
+
+bool AbstractPathCache::find(std::size_t level, std::size_t start_id, std::size_t goal_id,
+                             std::vector<std::size_t> &path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entry_map.find(Key{level, start_id, goal_id});
+    if (it != entry_map.end()) {
+        path = it->second->path;
+        touch(it->second);
+        ++hits;
+        return true;
+    }
+    // The path of the reversed query, walked backwards
+    it = entry_map.find(Key{level, goal_id, start_id});
+    if (it != entry_map.end()) {
+        path.assign(it->second->path.rbegin(), it->second->path.rend());
+        touch(it->second);
+        ++hits;
+        return true;
+    }
+    ++misses;
+    return false;
+}
+
+void AbstractPathCache::insert(std::size_t level, const std::vector<std::size_t> &path) {
+    assert(!path.empty());
+    const Key key{level, path.front(), path.back()};
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entry_map.find(key);
+    if (it != entry_map.end()) {
+        it->second->path = path;
+        touch(it->second);
+        return;
+    }
+    if (entries.size() >= capacity) {
+        erase(std::prev(entries.end()));
+    }
+    entries.push_front({key, path});
+    entry_map.emplace(key, entries.begin());
+}
+
+void AbstractPathCache::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    entry_map.clear();
+}
+
+void AbstractPathCache::invalidate_node(std::size_t level, std::size_t node_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end();) {
+        const auto next = std::next(it);
+        if (it->key.level == level && std::find(it->path.begin(), it->path.end(), node_id) != it->path.end()) {
+            erase(it);
+        }
+        it = next;
+    }
+}
+
+std::size_t AbstractPathCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t AbstractPathCache::get_hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+std::size_t AbstractPathCache::get_misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+void AbstractPathCache::touch(std::list<Entry>::iterator it) {
+    entries.splice(entries.begin(), entries, it);
+}
+
+void AbstractPathCache::erase(std::list<Entry>::iterator it) {
+    entry_map.erase(it->key);
+    entries.erase(it);
+}
+
+}    // namespace tpl_search
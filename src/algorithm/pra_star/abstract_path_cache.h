@@ -0,0 +1,104 @@
+// File: abstract_path_cache.h
+// Cache of abstract paths shared between PRA* queries
+
+#ifndef PRA_ALGORITHM_PRA_STAR_ABSTRACT_PATH_CACHE_H
+#define PRA_ALGORITHM_PRA_STAR_ABSTRACT_PATH_CACHE_H
+
+#include <absl/container/flat_hash_map.h>
+
+#include <list>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace tpl_search {
+
+// Bounded least recently used cache of the abstract paths PRA* starts from, keyed by level and the abstract start and
+// goal nodes. Paths are stored untruncated, as node IDs of their level. Graph edges are undirected, so a path is also
+// found for the reversed query. Safe to share between threads, every call takes a single lock.
+class AbstractPathCache {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    /**
+     * @param capacity Most paths held, the least recently used is evicted beyond it
+     */
+    explicit AbstractPathCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    AbstractPathCache(const AbstractPathCache &) = delete;
+    AbstractPathCache &operator=(const AbstractPathCache &) = delete;
+
+    /**
+     * Look up the path between two abstract nodes, counted as a hit or a miss
+     * @param level Level of the nodes
+     * @param start_id ID of the abstract start node
+     * @param goal_id ID of the abstract goal node
+     * @param path Set to the path from start to goal on a hit
+     * @return True on a hit
+     */
+    bool find(std::size_t level, std::size_t start_id, std::size_t goal_id, std::vector<std::size_t> &path);
+
+    /**
+     * Add the path between two abstract nodes, replacing any held for the same nodes
+     * @param level Level of the nodes
+     * @param path Path from the abstract start to the abstract goal node
+     */
+    void insert(std::size_t level, const std::vector<std::size_t> &path);
+
+    /**
+     * Drop every path, to be called when the graph changes
+     */
+    void invalidate();
+
+    /**
+     * Drop every path through a node, to be called when the node or its edges change
+     * @note Scans every path held
+     * @param level Level of the node
+     * @param node_id ID of the node
+     */
+    void invalidate_node(std::size_t level, std::size_t node_id);
+
+    std::size_t size() const;
+
+    std::size_t get_hits() const;
+
+    std::size_t get_misses() const;
+
+private:
+    struct Key {
+        std::size_t level;
+        std::size_t start_id;
+        std::size_t goal_id;
+
+        bool operator==(const Key &other) const {
+            return level == other.level && start_id == other.start_id && goal_id == other.goal_id;
+        }
+
+        template <typename H>
+        friend H AbslHashValue(H state, const Key &key) {
+            return H::combine(std::move(state), key.level, key.start_id, key.goal_id);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<std::size_t> path;
+    };
+
+    // Move an entry to the front of the recency list, only to be called with the lock held
+    void touch(std::list<Entry>::iterator it);
+
+    // Remove an entry, only to be called with the lock held
+    void erase(std::list<Entry>::iterator it);
+
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::list<Entry> entries;                                          // Most recently used first
+    absl::flat_hash_map<Key, std::list<Entry>::iterator> entry_map;    // Entry of each key held
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_PRA_STAR_ABSTRACT_PATH_CACHE_H
@@ -0,0 +1,67 @@
+// File: k_controller.cpp
+// Choice of the PRA* truncation parameter K from a target amount of work per iteration
+
+#include "k_controller.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace tpl_search {
+
+namespace {
+
+// Weight of each new measurement in the running averages
+constexpr double AVERAGE_WEIGHT = 0.125;
+
+/**
+ * Add a measurement to a running average
+ * @param average The average, negative if nothing has been measured yet
+ * @param value The measurement
+ */
+void add_to_average(double &average, double value) {
+    average = average < 0 ? value : average + AVERAGE_WEIGHT * (value - average);
+}
+
+}    // namespace
+
+KController::KController(const SearchBudget &target, std::size_t initial_k)
+    : target(target), initial_k(std::clamp(initial_k, MIN_K, MAX_K)) {
+    assert(target.is_limited());
+}
+
+std::size_t KController::get_k(bool is_first, std::size_t starting_level) const {
+    const double starting_cost = is_first ? first_starting_cost : later_starting_cost;
+    if (starting_cost < 0 || refinement_cost <= 0) {
+        return initial_k;
+    }
+    // The refinement gets whatever the starting level search leaves of the target, iterations starting on the grid
+    // are costed as if they had a level to refine
+    const double target_cost = target.max_expanded > 0 ? static_cast<double>(target.max_expanded)
+                                                       : target.seconds_limit;
+    const double num_levels = static_cast<double>(std::max<std::size_t>(starting_level, 1));
+    const double k = std::floor((target_cost - starting_cost) / (refinement_cost * num_levels));
+    return k < static_cast<double>(MIN_K) ? MIN_K : std::min(static_cast<std::size_t>(k), MAX_K);
+}
+
+void KController::update(std::span<const LevelSearch> level_searches, std::size_t k, bool is_first, bool is_last) {
+    if (level_searches.empty()) {
+        return;
+    }
+    add_to_average(is_first ? first_starting_cost : later_starting_cost, get_cost(level_searches.front()));
+    // Iterations starting on the grid have nothing to refine
+    if (is_last || level_searches.size() == 1) {
+        return;
+    }
+    double cost = 0;
+    for (const LevelSearch &level_search : level_searches.subspan(1)) {
+        cost += get_cost(level_search);
+    }
+    add_to_average(refinement_cost, cost / static_cast<double>(k * level_searches.front().level));
+}
+
+double KController::get_cost(const LevelSearch &level_search) const {
+    return target.max_expanded > 0 ? static_cast<double>(level_search.expanded) : level_search.duration;
+}
+
+}    // namespace tpl_search
@@ -0,0 +1,64 @@
+// File: k_controller.h
+// Choice of the PRA* truncation parameter K from a target amount of work per iteration
+
+#ifndef PRA_ALGORITHM_PRA_STAR_K_CONTROLLER_H
+#define PRA_ALGORITHM_PRA_STAR_K_CONTROLLER_H
+
+#include <span>
+
+#include "algorithm/common/search_budget.h"
+#include "algorithm/common/search_output.h"
+
+namespace tpl_search {
+
+// Picks the K of each PRA* iteration so its level searches fit a target, such as the work allowed before the first
+// move. The work of an iteration is modelled as that of its starting level search plus that of refining the truncated
+// path on each level below, which grows in proportion to K. Both are learned online from the level searches PRA*
+// reports, as running averages shared by every query the controller is used for. The starting level search of first
+// iterations is estimated apart from later ones, whose starting level path is often kept without searching.
+// Not safe to share between threads.
+class KController {
+public:
+    static constexpr std::size_t MIN_K = 2;
+    static constexpr std::size_t MAX_K = 256;
+    static constexpr std::size_t DEFAULT_INITIAL_K = 16;
+
+    /**
+     * @param target Work each iteration should fit in, in expansions if max_expanded is set and in thread CPU time
+     * otherwise. Must be limited.
+     * @param initial_k K picked until enough iterations have been measured
+     */
+    explicit KController(const SearchBudget &target, std::size_t initial_k = DEFAULT_INITIAL_K);
+
+    /**
+     * Get the K to truncate an iteration to
+     * @param is_first Whether the iteration is the first of its query
+     * @param starting_level Level the iteration starts from, its path is refined on every level below
+     * @return K picked from the estimates, between MIN_K and MAX_K
+     */
+    std::size_t get_k(bool is_first, std::size_t starting_level) const;
+
+    /**
+     * Update the estimates from the level searches of a completed iteration
+     * @param level_searches Level searches of the iteration in the order they were done, starting level first
+     * @param k K the iteration was truncated to
+     * @param is_first Whether the iteration was the first of its query
+     * @param is_last Whether the iteration reached the goal, its path may be shorter than K so its refinement isn't
+     * measured
+     */
+    void update(std::span<const LevelSearch> level_searches, std::size_t k, bool is_first, bool is_last);
+
+private:
+    // Cost of a level search in the unit of the target
+    double get_cost(const LevelSearch &level_search) const;
+
+    SearchBudget target;
+    std::size_t initial_k;
+    double first_starting_cost = -1;    // Average starting level cost of first iterations, negative until measured
+    double later_starting_cost = -1;    // Average starting level cost of later iterations, negative until measured
+    double refinement_cost = -1;        // Average cost of refining a level per unit of K, negative until measured
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_PRA_STAR_K_CONTROLLER_H
@@ -0,0 +1,32 @@
+// File: level_search_memo.cpp
+// Abstract level searches shared between PRA* queries planning through the same nodes
+
+#include "level_search_memo.h"
+
+#include <cassert>
+
+namespace tpl_search {
+
+bool LevelSearchMemo::find(std::size_t level, std::size_t start_id, std::size_t goal_id,
+                           const std::vector<std::size_t> &parent_path, std::vector<std::size_t> &path) {
+    const auto it = path_map.find(Key{level, start_id, goal_id, parent_path});
+    if (it == path_map.end()) {
+        ++misses;
+        return false;
+    }
+    path = it->second;
+    ++hits;
+    return true;
+}
+
+void LevelSearchMemo::insert(std::size_t level, const std::vector<std::size_t> &parent_path,
+                             const std::vector<std::size_t> &path) {
+    assert(!path.empty());
+    path_map.insert_or_assign(Key{level, path.front(), path.back(), parent_path}, path);
+}
+
+void LevelSearchMemo::clear() {
+    path_map.clear();
+}
+
+}    // namespace tpl_search
@@ -0,0 +1,85 @@
+// File: level_search_memo.h
+// Abstract level searches shared between PRA* queries planning through the same nodes
+
+#ifndef PRA_ALGORITHM_PRA_STAR_LEVEL_SEARCH_MEMO_H
+#define PRA_ALGORITHM_PRA_STAR_LEVEL_SEARCH_MEMO_H
+
+#include <absl/container/flat_hash_map.h>
+
+#include <utility>
+#include <vector>
+
+namespace tpl_search {
+
+// Paths found by the abstract level searches of PRA* queries, kept so queries planning through the same nodes, such
+// as a group of agents moving together, search each of them once. A level search is only found again between the
+// same nodes of the same level, constrained to the children of the same truncated path on the level above, so a query
+// gets the path it would have searched for itself. Grid searches aren't held, every query refines its own grid path.
+// Unbounded, meant to be kept for one group of queries and cleared before the next. Not safe to share between threads.
+class LevelSearchMemo {
+public:
+    LevelSearchMemo() = default;
+
+    LevelSearchMemo(const LevelSearchMemo &) = delete;
+    LevelSearchMemo &operator=(const LevelSearchMemo &) = delete;
+
+    /**
+     * Look up the path of a level search, counted as a hit or a miss
+     * @param level Level searched
+     * @param start_id ID of the start node
+     * @param goal_id ID of the goal node
+     * @param parent_path Truncated path on the level above the search was constrained to, empty if unconstrained
+     * @param path Set to the path from start to goal on a hit
+     * @return True on a hit
+     */
+    bool find(std::size_t level, std::size_t start_id, std::size_t goal_id,
+              const std::vector<std::size_t> &parent_path, std::vector<std::size_t> &path);
+
+    /**
+     * Add the path of a level search, replacing any held for the same search
+     * @param level Level searched
+     * @param parent_path Truncated path on the level above the search was constrained to, empty if unconstrained
+     * @param path Path from the start to the goal node
+     */
+    void insert(std::size_t level, const std::vector<std::size_t> &parent_path, const std::vector<std::size_t> &path);
+
+    /**
+     * Drop every path, to be called between groups of queries or when the graph changes
+     */
+    void clear();
+
+    std::size_t size() const {
+        return path_map.size();
+    }
+
+    std::size_t get_hits() const {
+        return hits;
+    }
+
+    std::size_t get_misses() const {
+        return misses;
+    }
+
+private:
+    struct Key {
+        std::size_t level;
+        std::size_t start_id;
+        std::size_t goal_id;
+        std::vector<std::size_t> parent_path;
+
+        bool operator==(const Key &other) const = default;
+
+        template <typename H>
+        friend H AbslHashValue(H state, const Key &key) {
+            return H::combine(std::move(state), key.level, key.start_id, key.goal_id, key.parent_path);
+        }
+    };
+
+    absl::flat_hash_map<Key, std::vector<std::size_t>> path_map;    // Path of each level search held
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_PRA_STAR_LEVEL_SEARCH_MEMO_H
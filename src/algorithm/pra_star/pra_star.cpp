@@ -5,113 +5,726 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "algorithm/a_star/a_star.h"
 #include "algorithm/common/graph.h"
 #include "algorithm/common/graph_generator.h"
+#include "algorithm/common/octile_cost.h"
+#include "util/timer.h"
 
 namespace tpl_search {
 
-SearchOutput pra_star(HierarchicalGraph &hierarchical_graph, std::size_t k, const GridPosition &start_pos,
-                      const GridPosition &goal_pos) {
-    std::size_t starting_level = hierarchical_graph.num_layers() / 2;
-    std::unordered_set<std::size_t> constrained_nodes;
-    SearchOutput search_output, astar_output;
-    GridPosition current_start_pos, current_goal_pos;
+namespace {
+
+// Hop count of nodes further than STARTING_LEVEL_HOPS from the goal
+constexpr std::uint8_t FAR_HOPS = STARTING_LEVEL_HOPS + 1;
+
+// Fewest starting level hops refined by each thread of parallel PRA*, shorter paths are split over fewer threads
+constexpr std::size_t MIN_WINDOW_HOPS = 4;
+
+/**
+ * Get the nodes holding a grid cell on every level
+ * @param graph The hierarchical graph
+ * @param grid_index Dense index of the cell on the layer 0 grid
+ * @return Dense index of the node holding the cell on each level
+ */
+std::vector<std::size_t> get_ancestor_indices(const HierarchicalGraph &graph, std::size_t grid_index) {
+    std::vector<std::size_t> indices{grid_index};
+    for (std::size_t level = 1; level < graph.num_layers(); ++level) {
+        indices.push_back(graph.get_parent_index(level - 1, indices.back()));
+    }
+    return indices;
+}
+
+/**
+ * Get the cost of a grid path, accumulated exactly
+ * @param grid The layer 0 grid graph
+ * @param path Layer 0 node IDs of the path
+ * @return Cost of the path
+ */
+double get_grid_path_cost(const FlatGraph &grid, const std::vector<std::size_t> &path) {
+    OctileCost path_cost;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        path_cost += octile_distance(*grid.get_node(path[i])->represented_positions.begin(),
+                                     *grid.get_node(path[i - 1])->represented_positions.begin());
+    }
+    return path_cost.to_double();
+}
+
+/**
+ * Count the hops from the goal to the nodes of a layer within STARTING_LEVEL_HOPS of it, ignoring constrained nodes
+ * @param graph The layer to count over
+ * @param goal_index Dense index of the goal node
+ * @param hops Set to the hops to each node by dense index, FAR_HOPS for nodes further away
+ */
+void count_goal_hops(const FlatGraph &graph, std::size_t goal_index, std::vector<std::uint8_t> &hops) {
+    hops.assign(graph.num_nodes(), FAR_HOPS);
+    hops[goal_index] = 0;
+    // Breadth first search, one frontier per hop
+    std::vector<std::size_t> frontier{goal_index}, next_frontier;
+    for (std::uint8_t hop = 1; hop < FAR_HOPS && !frontier.empty(); ++hop) {
+        next_frontier.clear();
+        for (const std::size_t index : frontier) {
+            for (const std::size_t neighbour_index : graph.get_neighbour_indices(index)) {
+                if (hops[neighbour_index] == FAR_HOPS) {
+                    hops[neighbour_index] = hop;
+                    next_frontier.push_back(neighbour_index);
+                }
+            }
+        }
+        std::swap(frontier, next_frontier);
+    }
+}
 
-    // K=0 indicates K=infinity
-    if (k < 1) {
-        k = std::numeric_limits<std::size_t>::max();
+/**
+ * Pick the level to start a PRA* iteration from, the lowest where the abstract start and goal are within
+ * STARTING_LEVEL_HOPS of each other. Short queries are searched on the grid alone, long ones from high enough up
+ * that the abstract search stays small.
+ * Every edge joins the same or neighbouring parents, so hop counts never grow going up a level and the levels are
+ * counted downward from one known to be close enough until the first which isn't.
+ * @param graph The hierarchical graph
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param start_indices Dense index of the node holding the start on each level
+ * @param goal_indices Dense index of the node holding the goal on each level
+ * @param close_level A level known to be close enough, or the top level
+ * @param goal_hops Hops from goal nodes on each level by the dense index of the goal node, counted on the first query
+ * of a level with the same goal node and shared by every query after it
+ * @return Level to start from, the top level if no lower one is close enough
+ */
+std::size_t select_starting_level(
+    HierarchicalGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+    const std::vector<std::size_t> &start_indices, const std::vector<std::size_t> &goal_indices,
+    std::size_t close_level, std::vector<std::unordered_map<std::size_t, std::vector<std::uint8_t>>> &goal_hops) {
+    const std::size_t chebyshev_distance = std::max(start_pos.x > goal_pos.x ? start_pos.x - goal_pos.x
+                                                                              : goal_pos.x - start_pos.x,
+                                                    start_pos.y > goal_pos.y ? start_pos.y - goal_pos.y
+                                                                              : goal_pos.y - start_pos.y);
+    while (close_level > 0) {
+        const std::size_t level = close_level - 1;
+        const FlatGraph &layer = graph.get_layer(level);
+        // A path of h hops spans at most h + 1 nodes and h steps between them, levels too fine to span the distance
+        // in STARTING_LEVEL_HOPS are ruled out without counting
+        const std::size_t extent = layer.get_max_cell_extent();
+        if (chebyshev_distance > STARTING_LEVEL_HOPS * (extent + 1) + extent) {
+            break;
+        }
+        const auto [hops_it, is_new] = goal_hops[level].try_emplace(goal_indices[level]);
+        if (is_new) {
+            count_goal_hops(layer, goal_indices[level], hops_it->second);
+        }
+        if (hops_it->second[start_indices[level]] == FAR_HOPS) {
+            break;
+        }
+        --close_level;
     }
+    return close_level;
+}
 
-    std::vector<GridPosition> solution_path{start_pos};
+/**
+ * Get the part of a budget left after some work
+ * @param budget The full budget
+ * @param expanded Expansions done so far
+ * @param timer Timer started with the search
+ * @param remaining Set to the budget left
+ * @return False if any part of the budget is spent
+ */
+bool get_remaining_budget(const SearchBudget &budget, std::size_t expanded, ThreadTimer &timer,
+                          SearchBudget &remaining) {
+    remaining = {};
+    if (budget.max_expanded > 0) {
+        if (expanded >= budget.max_expanded) {
+            return false;
+        }
+        remaining.max_expanded = budget.max_expanded - expanded;
+    }
+    if (budget.seconds_limit > 0) {
+        remaining.seconds_limit = timer.get_time_remaining();
+        if (remaining.seconds_limit <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Run a level search with a budget, dropped once finished
+ * @param search The level search, started or continued from where its last run stopped
+ * @param budget Work allowed for this run
+ * @param output Set to the results so far, the durations and counts cover every run
+ * @return Status of the search after this run
+ */
+template <typename SearchT>
+SearchStatus run_level_search(std::optional<SearchT> &search, const SearchBudget &budget, SearchOutput &output) {
+    const SearchStatus status = search->run(budget);
+    output = search->get_output();
+    if (status != SearchStatus::InProgress) {
+        search.reset();
+    }
+    return status;
+}
+
+/**
+ * Refine a window of the starting level path down to the grid, each level constrained to the children of the path
+ * found on the level above. The grid path is not truncated.
+ * @param graph The hierarchical graph, only read so windows can be refined concurrently
+ * @param starting_level Level of the window
+ * @param window Node IDs of the window on the starting level, with one node of overlap past each end
+ * @param start_indices Dense index of the node holding the cell the window starts from on each level
+ * @param goal_indices Dense index of the node holding the cell the window ends at on each level
+ * @param window_index Position of the window along the path, reported as the iteration of its level searches
+ * @param context Search workspace of the thread refining the window
+ * @param output Set to the results, the path is the grid path of the window and empty if none was found
+ */
+void refine_window(HierarchicalGraph &graph, std::size_t starting_level, const std::vector<std::size_t> &window,
+                   const std::vector<std::size_t> &start_indices, const std::vector<std::size_t> &goal_indices,
+                   std::size_t window_index, SearchContext &context, SearchOutput &output) {
+    std::vector<std::size_t> path = window;
+    std::unordered_set<std::size_t> corridor;
+    for (std::size_t level = starting_level; level-- > 0 && !path.empty();) {
+        corridor.clear();
+        for (const std::size_t node_id : path) {
+            const auto &child_node_ids = graph.get_parent_child_mapping(level, node_id);
+            corridor.insert(child_node_ids.begin(), child_node_ids.end());
+        }
+        const FlatGraph &layer = graph.get_layer(level);
+        SearchOutput astar_output =
+            a_star_nodes(layer, layer.get_node_id(start_indices[level]), layer.get_node_id(goal_indices[level]), {},
+                         context, &corridor);
+        output.expanded += astar_output.expanded;
+        output.generated += astar_output.generated;
+        output.duration += astar_output.duration;
+        output.level_searches.push_back({window_index, level, astar_output.expanded, astar_output.generated,
+                                         astar_output.duration, corridor.size(), false, false});
+        path = std::move(astar_output.path_node_ids);
+    }
+    output.path_node_ids = std::move(path);
+}
+
+/**
+ * Search the grid again across the seam between two windows refined in parallel, within the overlap of their
+ * corridors: the cells of the node the windows meet at and its neighbours on the starting level path. The stretch of
+ * the joined path inside the overlap is replaced, which is itself within the overlap so the cost never grows.
+ * @param graph The hierarchical graph, only read so seams can be searched concurrently
+ * @param starting_level Level of the windows
+ * @param overlap Node IDs of the overlap on the starting level
+ * @param before Grid path of the window ending at the seam
+ * @param after Grid path of the window starting at the seam
+ * @param window_index Position of the window starting at the seam, reported as the iteration of the search
+ * @param context Search workspace of the thread searching the seam
+ * @param output Set to the results, the path replaces the end of before from the node at seam_begin and the start of
+ * after up to the node at seam_end
+ * @param seam_begin Set to where the stretch replaced starts in before
+ * @param seam_end Set to where the stretch replaced ends in after
+ */
+void refine_seam(HierarchicalGraph &graph, std::size_t starting_level, const std::vector<std::size_t> &overlap,
+                 const std::vector<std::size_t> &before, const std::vector<std::size_t> &after,
+                 std::size_t window_index, SearchContext &context, SearchOutput &output, std::size_t &seam_begin,
+                 std::size_t &seam_end) {
+    std::unordered_set<std::size_t> corridor(overlap.begin(), overlap.end()), child_corridor;
+    for (std::size_t level = starting_level; level-- > 0;) {
+        child_corridor.clear();
+        for (const std::size_t node_id : corridor) {
+            const auto &child_node_ids = graph.get_parent_child_mapping(level, node_id);
+            child_corridor.insert(child_node_ids.begin(), child_node_ids.end());
+        }
+        std::swap(corridor, child_corridor);
+    }
+    // The windows meet at a cell of the overlap, the stretch replaced is as long as the path stays within it
+    seam_begin = before.size() - 1;
+    while (seam_begin > 0 && corridor.contains(before[seam_begin - 1])) {
+        --seam_begin;
+    }
+    seam_end = 0;
+    while (seam_end + 1 < after.size() && corridor.contains(after[seam_end + 1])) {
+        ++seam_end;
+    }
+    output = a_star_nodes(graph.get_layer(0), before[seam_begin], after[seam_end], {}, context, &corridor);
+    output.level_searches.push_back(
+        {window_index, 0, output.expanded, output.generated, output.duration, corridor.size(), false, false});
+    assert(!output.path_node_ids.empty());
+}
+
+/**
+ * Refine every segment of a PRA* path within a budget
+ * @param path_iterator Iterator of the search, with no segment refined yet
+ * @param grid The layer 0 grid graph
+ * @param start_pos The starting position
+ * @param budget Work allowed over all level searches
+ * @return Results of search, see pra_star
+ */
+SearchOutput refine_path(PRAStarPathIterator &path_iterator, const FlatGraph &grid, const GridPosition &start_pos,
+                         const SearchBudget &budget) {
+    std::vector<std::size_t> path{grid.get_pos_node_id(start_pos)};
+
+    ThreadTimer timer(budget.seconds_limit);
+    timer.start();
+    SearchBudget remaining_budget;
 
     // Loop until we complete an interation with current goal matching target goal
-    current_start_pos = start_pos;
-    do {
-        current_goal_pos = goal_pos;
-        for (std::size_t i = 0; i <= starting_level; ++i) {
-            std::size_t current_level = starting_level - i;
+    bool is_partial = false;
+    while (!path_iterator.is_done()) {
+        if (!get_remaining_budget(budget, path_iterator.get_output().expanded, timer, remaining_budget)) {
+            is_partial = true;
+            break;
+        }
+        const SearchStatus segment_status = path_iterator.next_segment(remaining_budget);
+        if (segment_status == SearchStatus::NoPath) {
+            path.clear();
+            break;
+        }
+        // Ensure we don't double count start/ends from previous iterations
+        const std::vector<std::size_t> &segment = path_iterator.get_segment();
+        path.insert(path.end(), segment.begin() + 1, segment.end());
+        if (segment_status == SearchStatus::InProgress) {
+            // The partial grid path of the iteration the budget ran out in ends the path
+            is_partial = true;
+            break;
+        }
+    }
+
+    SearchOutput search_output = path_iterator.get_output();
+    search_output.is_partial = is_partial;
+    search_output.path_cost = path.empty() ? -1 : get_grid_path_cost(grid, path);
+    search_output.path_node_ids = std::move(path);
+
+    return search_output;
+}
+
+}    // namespace
+
+PRAStarPathIterator::PRAStarPathIterator(HierarchicalGraph &hierarchical_graph, std::size_t k,
+                                         const GridPosition &start_pos, const GridPosition &goal_pos,
+                                         SearchContext &context, AbstractPathCache *path_cache,
+                                         KController *k_controller, LevelSearchMemo *level_search_memo)
+    : hierarchical_graph(hierarchical_graph),
+      k(k < 1 ? std::numeric_limits<std::size_t>::max() : k),    // K=0 indicates K=infinity
+      goal_pos(goal_pos),
+      context(context),
+      path_cache(path_cache),
+      k_controller(k_controller),
+      level_search_memo(level_search_memo),
+      current_start_pos(start_pos),
+      start_indices(hierarchical_graph.num_layers()),
+      goal_indices(hierarchical_graph.num_layers()),
+      goal_hops(hierarchical_graph.num_layers()) {
+    // The goal is looked up once, every search after refers to nodes by index
+    const FlatGraph &grid = hierarchical_graph.get_layer(0);
+    start_indices[0] = grid.get_node_index(grid.get_pos_node_id(start_pos));
+    goal_indices[0] = grid.get_node_index(grid.get_pos_node_id(goal_pos));
+    for (std::size_t level = 1; level < hierarchical_graph.num_layers(); ++level) {
+        goal_indices[level] = hierarchical_graph.get_parent_index(level - 1, goal_indices[level - 1]);
+    }
+    // Size the workspaces once to the largest layers searched with each cost type
+    context.get_workspace<OctileCost>().reserve(hierarchical_graph.get_layer(0).num_nodes());
+    if (hierarchical_graph.num_layers() > 1) {
+        context.get_workspace<double>().reserve(hierarchical_graph.get_layer(1).num_nodes());
+    }
+}
+
+void PRAStarPathIterator::start_iteration() {
+    // The start is held by its ancestors on every level, the goal of each level below the starting level is the
+    // sub-goal picked on the level above
+    for (std::size_t level = 1; level < hierarchical_graph.num_layers(); ++level) {
+        start_indices[level] = hierarchical_graph.get_parent_index(level - 1, start_indices[level - 1]);
+    }
+
+    // This segment starts within the window of the last path planned on the starting level, whose rest is still a
+    // shortest path to the goal
+    const auto remaining_begin =
+        std::find(remaining_path.begin(), remaining_path.end(),
+                  hierarchical_graph.get_layer(remaining_level).get_node_id(start_indices[remaining_level]));
+    const std::size_t remaining_hops = remaining_begin == remaining_path.end()
+                                           ? std::numeric_limits<std::size_t>::max()
+                                           : static_cast<std::size_t>(remaining_path.end() - remaining_begin) - 1;
+
+    // Picked again each iteration, as truncation brings the start closer to the goal, the path kept proves its level
+    // close enough if it's short enough
+    if (iteration == 0 && first_starting_level.has_value()) {
+        starting_level = *first_starting_level;
+    } else {
+        starting_level = select_starting_level(
+            hierarchical_graph, current_start_pos, goal_pos, start_indices, goal_indices,
+            remaining_hops <= STARTING_LEVEL_HOPS ? remaining_level : hierarchical_graph.num_layers() - 1, goal_hops);
+    }
+    // The path is only planned again once the starting level changes
+    is_reused = remaining_begin != remaining_path.end() && starting_level == remaining_level;
+    kept_begin = static_cast<std::size_t>(remaining_begin - remaining_path.begin());
+    if (k_controller != nullptr) {
+        k = k_controller->get_k(iteration == 0, starting_level);
+    }
+    level_step = 0;
+    current_goal_id = hierarchical_graph.get_layer(starting_level).get_node_id(goal_indices[starting_level]);
+    first_level_search = search_output.level_searches.size();
+    parent_path.clear();
+    is_iterating = true;
+}
+
+void PRAStarPathIterator::start_level_search(std::size_t level) {
+    const FlatGraph &graph = hierarchical_graph.get_layer(level);
+    // Constrain the search to the children of the path on the level above, the starting level to the constrained
+    // node set of its layer
+    constrained_nodes.clear();
+    for (const auto &path_node_id : parent_path) {
+        const auto &child_node_ids = hierarchical_graph.get_parent_child_mapping(level, path_node_id);
+        constrained_nodes.insert(child_node_ids.begin(), child_node_ids.end());
+    }
+    const std::unordered_set<std::size_t> *corridor = parent_path.empty() ? nullptr : &constrained_nodes;
+    const std::size_t start_index = start_indices[level];
+    const std::size_t goal_index = graph.get_node_index(current_goal_id);
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph, corridor);
+        grid_search.emplace(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), context);
+    } else {
+        const AbstractGraphView view(graph, corridor);
+        abstract_search.emplace(view, start_index, goal_index, AbstractOctileHeuristic(view, goal_index), context);
+    }
+}
+
+void PRAStarPathIterator::set_first_starting_level(std::size_t level) {
+    assert(iteration == 0 && !is_iterating && level < hierarchical_graph.num_layers());
+    first_starting_level = level;
+}
+
+SearchStatus PRAStarPathIterator::next_segment(const SearchBudget &budget) {
+    assert(status == SearchStatus::InProgress);
+    if (!is_iterating) {
+        start_iteration();
+    }
+
+    ThreadTimer timer(budget.seconds_limit);
+    timer.start();
+    SearchBudget remaining_budget;
+    std::size_t expanded = 0;
+
+    SearchOutput astar_output;
+    for (; level_step <= starting_level; ++level_step) {
+        const std::size_t current_level = starting_level - level_step;
+
+        // Search A* over current graph layer
+        FlatGraph &current_graph = hierarchical_graph.get_layer(current_level);
+        const std::size_t current_start_id = current_graph.get_node_id(start_indices[current_level]);
 #ifdef DEBUG
-            std::cout << "Searching from " << current_start_pos << " to " << current_goal_pos << " at level "
-                      << current_level << std::endl;
+        std::cout << "Searching from node " << current_start_id << " to node " << current_goal_id << " at level "
+                  << current_level << std::endl;
 #endif
-
-            // Search A* over current graph layer
-            FlatGraph &current_graph = hierarchical_graph.get_layer(current_level);
-            current_graph.set_constrained_nodes(constrained_nodes);
-            astar_output = a_star(current_graph, current_start_pos, current_goal_pos);
-
-            // Truncate to K parameter
-            astar_output.path_node_ids.resize(std::min(astar_output.path_node_ids.size(), k));
-            auto grid_posisions = current_graph.get_node(astar_output.path_node_ids.back())->represented_positions;
-            assert(astar_output.path_node_ids.size() > 0);
-            if (i < starting_level) {
-                // Find closest abstract node to goal on tail of truncated path
-                const auto child_nodes =
-                    hierarchical_graph.get_parent_child_mapping(current_level - 1, astar_output.path_node_ids.back());
-                FlatGraph &child_graph = hierarchical_graph.get_layer(current_level - 1);
-                std::size_t closest_child_id = *std::min_element(
-                    child_nodes.begin(), child_nodes.end(), [&](const std::size_t &lhs, const std::size_t &rhs) {
-                        auto child_1 = child_graph.get_node(lhs);
-                        auto child_2 = child_graph.get_node(rhs);
-                        auto lt_grid_pos = [&](const GridPosition &p1, const GridPosition &p2) {
-                            return distance(p1, current_goal_pos) < distance(p2, current_goal_pos);
-                        };
-                        GridPosition p_1 = *std::min_element(child_1->represented_positions.begin(),
-                                                             child_1->represented_positions.end(), lt_grid_pos);
-                        GridPosition p_2 = *std::min_element(child_2->represented_positions.begin(),
-                                                             child_2->represented_positions.end(), lt_grid_pos);
-
-                        return distance(p_1, goal_pos) < distance(p_2, goal_pos);
-                    });
-                grid_posisions = child_graph.get_node(closest_child_id)->represented_positions;
+        const bool is_kept = is_reused && level_step == 0;
+        // A level search stopped by the budget was looked up before it started
+        const bool is_resumed = grid_search.has_value() || abstract_search.has_value();
+        if (!is_kept && !get_remaining_budget(budget, expanded, timer, remaining_budget)) {
+            // Nothing left for this level, the segment is the grid path so far
+            if (!is_resumed) {
+                segment.assign(1, hierarchical_graph.get_layer(0).get_node_id(start_indices[0]));
+            }
+            return SearchStatus::InProgress;
+        }
+        // Every abstract search can be shared with other queries, grid paths are refined by each query
+        const bool is_shared = level_search_memo != nullptr && current_level > 0 && !is_kept;
+        const bool is_shared_hit =
+            is_shared && !is_resumed &&
+            level_search_memo->find(current_level, current_start_id, current_goal_id, parent_path, cached_path);
+        // Only the unconstrained search of the starting level is cached, grid paths aren't
+        const bool is_cached =
+            path_cache != nullptr && level_step == 0 && current_level > 0 && !is_kept && !is_shared_hit;
+        const bool is_hit =
+            is_shared_hit || (is_cached && !is_resumed &&
+                              path_cache->find(current_level, current_start_id, current_goal_id, cached_path));
+        if (is_kept || is_hit) {
+            astar_output = {};
+            if (is_kept) {
+                astar_output.path_node_ids.assign(remaining_path.begin() + static_cast<std::ptrdiff_t>(kept_begin),
+                                                  remaining_path.end());
+            } else {
+                astar_output.path_node_ids = cached_path;
             }
-            // Use closest grid position in this abstract node to represent new goal_pos
-            current_goal_pos = *std::min_element(grid_posisions.begin(), grid_posisions.end(),
-                                                 [&](const GridPosition &lhs, const GridPosition &rhs) {
-                                                     return distance(lhs, goal_pos) < distance(rhs, goal_pos);
-                                                 });
-
-            // Set constrained nodes for next level
-            constrained_nodes.clear();
-            if (i < starting_level) {
-                for (const auto &path_node_id : astar_output.path_node_ids) {
-                    const auto &child_node_ids =
-                        hierarchical_graph.get_parent_child_mapping(current_level - 1, path_node_id);
-                    constrained_nodes.insert(child_node_ids.begin(), child_node_ids.end());
+            search_output.level_searches.push_back({iteration, current_level, 0, 0, 0, 0, is_hit, is_kept});
+        } else {
+            if (!is_resumed) {
+                start_level_search(current_level);
+                search_output.level_searches.push_back(
+                    {iteration, current_level, 0, 0, 0, constrained_nodes.size(), false, false});
+            }
+            const SearchStatus level_status = grid_search.has_value()
+                                                  ? run_level_search(grid_search, remaining_budget, astar_output)
+                                                  : run_level_search(abstract_search, remaining_budget, astar_output);
+            // The level search is reported once, its counts cover every call
+            LevelSearch &level_search = search_output.level_searches.back();
+            expanded += astar_output.expanded - level_search.expanded;
+            search_output.expanded += astar_output.expanded - level_search.expanded;
+            search_output.generated += astar_output.generated - level_search.generated;
+            search_output.duration += astar_output.duration - level_search.duration;
+            level_search.expanded = astar_output.expanded;
+            level_search.generated = astar_output.generated;
+            level_search.duration = astar_output.duration;
+            if (level_status == SearchStatus::InProgress) {
+                // Continued on the next call, on the grid the partial path leads toward the sub-goal
+                if (current_level == 0) {
+                    segment = std::move(astar_output.path_node_ids);
+                } else {
+                    segment.assign(1, hierarchical_graph.get_layer(0).get_node_id(start_indices[0]));
                 }
+                return SearchStatus::InProgress;
             }
-            search_output.expanded += astar_output.expanded;
-            search_output.generated += astar_output.generated;
-            search_output.duration += astar_output.duration;
+        }
+        if (astar_output.path_node_ids.empty()) {
+            // Nothing joins the start to the goal, so there is no path on the levels below either
+            segment.clear();
+            status = SearchStatus::NoPath;
+            return status;
         }
 
-        // Save the current truncated path at the grounded level
-        // Ensure we don't double count start/ends from previous iterations
-        for (std::size_t i = 1; i < astar_output.path_node_ids.size(); ++i) {
-            solution_path.push_back(*std::begin(
-                hierarchical_graph.get_layer(0).get_node(astar_output.path_node_ids[i])->represented_positions));
+        if (is_cached && !is_hit) {
+            path_cache->insert(current_level, astar_output.path_node_ids);
+        }
+        if (is_shared && !is_shared_hit) {
+            level_search_memo->insert(current_level, parent_path, astar_output.path_node_ids);
+        }
+
+        if (level_step == 0 && !is_kept) {
+            remaining_level = starting_level;
+            remaining_path = astar_output.path_node_ids;
+        }
+
+        // Truncate to K parameter
+        astar_output.path_node_ids.resize(std::min(astar_output.path_node_ids.size(), k));
+        assert(astar_output.path_node_ids.size() > 0);
+        if (current_level > 0) {
+            // The sub-goal is the child of the tail of the truncated path closest to the goal, by the distance to its
+            // bounding box and then by its representative cell
+            const auto &child_nodes =
+                hierarchical_graph.get_parent_child_mapping(current_level - 1, astar_output.path_node_ids.back());
+            const FlatGraph &child_graph = hierarchical_graph.get_layer(current_level - 1);
+            auto goal_bounds = [&](std::size_t child_id) {
+                const CellBounds &bounds = child_graph.get_cell_bounds(child_graph.get_node_index(child_id));
+                return std::make_pair(bounds.lower_bound(goal_pos), distance(bounds.representative, goal_pos));
+            };
+            current_goal_id = *std::min_element(
+                child_nodes.begin(), child_nodes.end(),
+                [&](std::size_t lhs, std::size_t rhs) { return goal_bounds(lhs) < goal_bounds(rhs); });
+
+            // The truncated path constrains the next level
+            parent_path = std::move(astar_output.path_node_ids);
+        }
+    }
+    is_iterating = false;
+
+    // The grid path of the last level is the segment
+    segment = std::move(astar_output.path_node_ids);
+
+    // First completion of outer PRA* is time to come up with first move while intermixing planning + acting
+    if (search_output.first_move_duration == 0) {
+        search_output.first_move_duration = search_output.duration;
+    }
+
+    // If truncation occurs, our new start is end of previous path, the tail of a grid path is a single cell
+    const FlatGraph &grid = hierarchical_graph.get_layer(0);
+    start_indices[0] = grid.get_node_index(segment.back());
+    current_start_pos = grid.get_cell_bounds(start_indices[0]).representative;
+    const bool is_goal = start_indices[0] == goal_indices[0];
+    if (k_controller != nullptr) {
+        k_controller->update(std::span<const LevelSearch>(search_output.level_searches).subspan(first_level_search), k,
+                             iteration == 0, is_goal);
+    }
+    ++iteration;
+    if (is_goal) {
+        status = SearchStatus::Solved;
+    }
+    return SearchStatus::Solved;
+}
+
+SearchOutput pra_star(HierarchicalGraph &hierarchical_graph, std::size_t k, const GridPosition &start_pos,
+                      const GridPosition &goal_pos, SearchContext &context, const SearchBudget &budget,
+                      AbstractPathCache *path_cache, KController *k_controller, LevelSearchMemo *level_search_memo) {
+    PRAStarPathIterator path_iterator(hierarchical_graph, k, start_pos, goal_pos, context, path_cache, k_controller,
+                                      level_search_memo);
+    return refine_path(path_iterator, hierarchical_graph.get_layer(0), start_pos, budget);
+}
+
+std::vector<SearchOutput> pra_star_batch(HierarchicalGraph &hierarchical_graph, std::size_t k,
+                                         const std::vector<std::pair<GridPosition, GridPosition>> &queries,
+                                         SearchContext &context, AbstractPathCache *path_cache) {
+    // Group the queries by the starting level of their first iteration and their abstract start and goal on it
+    const FlatGraph &grid = hierarchical_graph.get_layer(0);
+    std::map<std::tuple<std::size_t, std::size_t, std::size_t>, std::vector<std::size_t>> groups;
+    // Queries to nodes of the same goal share its hop counts on each level
+    std::vector<std::unordered_map<std::size_t, std::vector<std::uint8_t>>> goal_hops(hierarchical_graph.num_layers());
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+        const auto &[start_pos, goal_pos] = queries[q];
+        const std::vector<std::size_t> start_indices =
+            get_ancestor_indices(hierarchical_graph, grid.get_node_index(grid.get_pos_node_id(start_pos)));
+        const std::vector<std::size_t> goal_indices =
+            get_ancestor_indices(hierarchical_graph, grid.get_node_index(grid.get_pos_node_id(goal_pos)));
+        const std::size_t starting_level =
+            select_starting_level(hierarchical_graph, start_pos, goal_pos, start_indices, goal_indices,
+                                  hierarchical_graph.num_layers() - 1, goal_hops);
+        groups[{starting_level, start_indices[starting_level], goal_indices[starting_level]}].push_back(q);
+    }
+
+    // The queries of a group run one after another, each searching only what the earlier ones haven't
+    std::vector<SearchOutput> search_outputs(queries.size());
+    LevelSearchMemo level_search_memo;
+    for (const auto &[group_key, group_queries] : groups) {
+        level_search_memo.clear();
+        for (const std::size_t q : group_queries) {
+            PRAStarPathIterator path_iterator(hierarchical_graph, k, queries[q].first, queries[q].second, context,
+                                              path_cache, nullptr, &level_search_memo);
+            path_iterator.set_first_starting_level(std::get<0>(group_key));
+            search_outputs[q] = refine_path(path_iterator, grid, queries[q].first, {});
         }
+    }
+    return search_outputs;
+}
+
+SearchOutput pra_star_parallel(HierarchicalGraph &hierarchical_graph, const GridPosition &start_pos,
+                               const GridPosition &goal_pos, std::size_t num_threads,
+                               std::vector<SearchContext> &contexts) {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    if (contexts.size() < num_threads) {
+        contexts.resize(num_threads);
+    }
+    WallTimer timer;
+    timer.start();
+
+    const FlatGraph &grid = hierarchical_graph.get_layer(0);
+    const std::vector<std::size_t> start_indices =
+        get_ancestor_indices(hierarchical_graph, grid.get_node_index(grid.get_pos_node_id(start_pos)));
+    const std::vector<std::size_t> goal_indices =
+        get_ancestor_indices(hierarchical_graph, grid.get_node_index(grid.get_pos_node_id(goal_pos)));
+    std::vector<std::unordered_map<std::size_t, std::vector<std::uint8_t>>> goal_hops(hierarchical_graph.num_layers());
+    const std::size_t starting_level = select_starting_level(hierarchical_graph, start_pos, goal_pos, start_indices,
+                                                             goal_indices, hierarchical_graph.num_layers() - 1,
+                                                             goal_hops);
 
-        // First completion of outer PRA* is time to come up with first move while intermixing planning + acting
-        if (search_output.first_move_duration == 0) {
-            search_output.first_move_duration = search_output.duration;
+    // The starting level is searched once on the calling thread
+    FlatGraph &starting_graph = hierarchical_graph.get_layer(starting_level);
+    starting_graph.set_constrained_nodes();
+    SearchOutput abstract_output =
+        a_star_nodes(starting_graph, starting_graph.get_node_id(start_indices[starting_level]),
+                     starting_graph.get_node_id(goal_indices[starting_level]), {}, contexts[0]);
+    SearchOutput search_output;
+    search_output.expanded = abstract_output.expanded;
+    search_output.generated = abstract_output.generated;
+    search_output.level_searches.push_back({0, starting_level, abstract_output.expanded, abstract_output.generated,
+                                            abstract_output.duration, 0, false, false});
+    const std::vector<std::size_t> &abstract_path = abstract_output.path_node_ids;
+
+    std::vector<std::size_t> path;
+    if (starting_level == 0 || abstract_path.empty()) {
+        path = abstract_path;
+    } else {
+        // Split the path into windows of about the same number of hops, one per thread. Windows meet at the
+        // representative cell of the node between them and overlap by one node on each side, so the grid path can
+        // approach the shared cell from either.
+        const std::size_t num_hops = abstract_path.size() - 1;
+        const std::size_t num_windows = std::clamp<std::size_t>(num_hops / MIN_WINDOW_HOPS, 1, num_threads);
+        std::vector<std::size_t> boundaries;
+        std::vector<std::vector<std::size_t>> boundary_indices;
+        for (std::size_t j = 0; j <= num_windows; ++j) {
+            boundaries.push_back(j * num_hops / num_windows);
+            if (j == 0) {
+                boundary_indices.push_back(start_indices);
+            } else if (j == num_windows) {
+                boundary_indices.push_back(goal_indices);
+            } else {
+                const CellBounds &bounds = starting_graph.get_cell_bounds(
+                    starting_graph.get_node_index(abstract_path[boundaries.back()]));
+                boundary_indices.push_back(get_ancestor_indices(
+                    hierarchical_graph, grid.get_node_index(grid.get_pos_node_id(bounds.representative))));
+            }
+        }
+
+        std::vector<SearchOutput> window_outputs(num_windows);
+        auto refine = [&](std::size_t j) {
+            const std::vector<std::size_t> window(
+                abstract_path.begin() + static_cast<std::ptrdiff_t>(boundaries[j] - (j > 0)),
+                abstract_path.begin() + static_cast<std::ptrdiff_t>(boundaries[j + 1] + (j + 1 < num_windows) + 1));
+            refine_window(hierarchical_graph, starting_level, window, boundary_indices[j], boundary_indices[j + 1], j,
+                          contexts[j], window_outputs[j]);
+        };
+        // The calling thread refines the first window, so the first move is known as soon as it's done
+        std::vector<std::thread> threads;
+        threads.reserve(num_windows - 1);
+        for (std::size_t j = 1; j < num_windows; ++j) {
+            threads.emplace_back(refine, j);
+        }
+        refine(0);
+        search_output.first_move_duration = timer.get_duration();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+        bool is_refined = true;
+        for (const SearchOutput &window_output : window_outputs) {
+            search_output.expanded += window_output.expanded;
+            search_output.generated += window_output.generated;
+            search_output.level_searches.insert(search_output.level_searches.end(),
+                                                window_output.level_searches.begin(),
+                                                window_output.level_searches.end());
+            is_refined = is_refined && !window_output.path_node_ids.empty();
         }
 
-        // If truncation occurs, our new start is end of previous path
-        current_start_pos = current_goal_pos;
-    } while (current_goal_pos != goal_pos);
+        if (is_refined) {
+            // The grid paths are only optimal up to the shared cells, each seam is searched again concurrently within
+            // the overlap of its windows
+            std::vector<SearchOutput> seam_outputs(num_windows);
+            std::vector<std::size_t> seam_begins(num_windows), seam_ends(num_windows);
+            auto refine_seam_at = [&](std::size_t j) {
+                const std::vector<std::size_t> overlap(
+                    abstract_path.begin() + static_cast<std::ptrdiff_t>(boundaries[j] - 1),
+                    abstract_path.begin() + static_cast<std::ptrdiff_t>(boundaries[j] + 2));
+                refine_seam(hierarchical_graph, starting_level, overlap, window_outputs[j - 1].path_node_ids,
+                            window_outputs[j].path_node_ids, j, contexts[j], seam_outputs[j], seam_begins[j],
+                            seam_ends[j]);
+            };
+            for (std::size_t j = 2; j < num_windows; ++j) {
+                threads.emplace_back(refine_seam_at, j);
+            }
+            if (num_windows > 1) {
+                refine_seam_at(1);
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
 
-    // Find total path cost
-    double path_cost = 0;
-    for (std::size_t i = 1; i < solution_path.size(); ++i) {
-        path_cost += distance(solution_path[i], solution_path[i - 1]);
+            // Stitch the windows and the seams between them, the overlaps of neighbouring seams are disjoint as
+            // windows span several hops
+            for (std::size_t j = 0; j < num_windows; ++j) {
+                const std::vector<std::size_t> &window_path = window_outputs[j].path_node_ids;
+                if (j > 0) {
+                    const SearchOutput &seam_output = seam_outputs[j];
+                    search_output.expanded += seam_output.expanded;
+                    search_output.generated += seam_output.generated;
+                    search_output.level_searches.insert(search_output.level_searches.end(),
+                                                        seam_output.level_searches.begin(),
+                                                        seam_output.level_searches.end());
+                    path.insert(path.end(), seam_output.path_node_ids.begin() + 1, seam_output.path_node_ids.end());
+                }
+                const std::size_t window_begin = j > 0 ? seam_ends[j] + 1 : 0;
+                const std::size_t window_end = j + 1 < num_windows ? seam_begins[j + 1] + 1 : window_path.size();
+                assert(window_begin <= window_end);
+                path.insert(path.end(), window_path.begin() + static_cast<std::ptrdiff_t>(window_begin),
+                            window_path.begin() + static_cast<std::ptrdiff_t>(window_end));
+            }
+        }
     }
-    search_output.path_cost = path_cost;
 
+    search_output.duration = timer.get_duration();
+    if (search_output.first_move_duration == 0) {
+        search_output.first_move_duration = search_output.duration;
+    }
+    search_output.path_cost = path.empty() ? -1 : get_grid_path_cost(grid, path);
+    search_output.path_node_ids = std::move(path);
     return search_output;
 }
 
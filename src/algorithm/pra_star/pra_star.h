@@ -4,22 +4,215 @@
 #ifndef PRA_ALGORITHM_PRA_STAR_H
 #define PRA_ALGORITHM_PRA_STAR_H
 
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "algorithm/a_star/a_star.h"
 #include "algorithm/common/graph.h"
+#include "algorithm/common/search_budget.h"
+#include "algorithm/common/search_context.h"
 #include "algorithm/common/search_output.h"
+#include "algorithm/pra_star/abstract_path_cache.h"
+#include "algorithm/pra_star/k_controller.h"
+#include "algorithm/pra_star/level_search_memo.h"
 #include "util/map.h"
 
 namespace tpl_search {
 
+// Most hops between the abstract start and goal on the level a PRA* iteration starts from
+constexpr std::size_t STARTING_LEVEL_HOPS = 16;
+
+// PRA* refined one truncated iteration at a time, so an agent can start moving along the first segment of the grid
+// path while the rest is left unsearched. Each iteration starts from the end of the previous segment, and the last
+// one ends at the goal. A segment can be refined over several calls with a budget each, such as one per game tick, the
+// level search the budget ran out in is continued where it stopped.
+class PRAStarPathIterator {
+public:
+    /**
+     * @param graph The graph to search over. The starting level of each iteration is searched within the constrained
+     * node set of its layer, the whole layer unless set, and the levels below within corridors held by the iterator,
+     * so the constrained node sets are left alone.
+     * @param k The K parameter for truncation for PRA*
+     * @param start_pos The starting position
+     * @param goal_pos The goal position
+     * @param context Search workspace reused by every level search, must outlive the iterator. While a segment is in
+     * progress its level search holds the workspace, so nothing else may search with the context until the segment
+     * is refined.
+     * @param path_cache Cache of the abstract paths each iteration starts from, none by default
+     * @param k_controller Picks the K of each iteration in place of k and learns from it, none by default
+     * @param level_search_memo Abstract level searches shared with the iterators of other agents, none by default
+     */
+    PRAStarPathIterator(HierarchicalGraph &graph, std::size_t k, const GridPosition &start_pos,
+                        const GridPosition &goal_pos, SearchContext &context = get_thread_search_context(),
+                        AbstractPathCache *path_cache = nullptr, KController *k_controller = nullptr,
+                        LevelSearchMemo *level_search_memo = nullptr);
+
+    // The level search in progress refers to the corridor of the iterator
+    PRAStarPathIterator(const PRAStarPathIterator &) = delete;
+    PRAStarPathIterator &operator=(const PRAStarPathIterator &) = delete;
+
+    /**
+     * Refine the next segment of the path, only to be called until is_done()
+     * @param budget Work allowed for this segment, unlimited by default
+     * @return Solved once the segment is refined. InProgress if the budget ran out first, the next call continues from
+     * where this one stopped. NoPath if the goal can't be reached, which ends the search.
+     */
+    SearchStatus next_segment(const SearchBudget &budget = {});
+
+    /**
+     * Give the starting level of the first iteration when it is already known, such as from grouping queries, so it
+     * isn't picked again. Only to be called before the first segment.
+     * @param level Lowest level where the abstract start and goal are within STARTING_LEVEL_HOPS of each other
+     */
+    void set_first_starting_level(std::size_t level);
+
+    /**
+     * Get the last segment refined
+     * @return Layer 0 node IDs from the end of the previous segment, or the start, to the end of this one. While a
+     * segment is in progress, the partial path of its grid search toward the node closest to the sub-goal, or only the
+     * start of the segment until the grid is searched.
+     */
+    const std::vector<std::size_t> &get_segment() const {
+        return segment;
+    }
+
+    /**
+     * Check whether the search has ended
+     * @return True once the whole path has been refined or no path was found
+     */
+    bool is_done() const {
+        return status != SearchStatus::InProgress;
+    }
+
+    /**
+     * Get how the search ended
+     * @return InProgress until is_done(), then Solved if the last segment ends at the goal and NoPath if there is no
+     * path to it
+     */
+    SearchStatus get_status() const {
+        return status;
+    }
+
+    /**
+     * Get the work done over all segments so far
+     * @return Results of search without the path, first_move_duration is the duration up to the first segment and
+     * level_searches holds every level search, one run over several calls is counted once with the work of every call
+     */
+    const SearchOutput &get_output() const {
+        return search_output;
+    }
+
+private:
+    // Pick the starting level of the next iteration and set up its first level search
+    void start_iteration();
+
+    // Start the search of a level toward the current goal, constrained to the children of the parent path
+    void start_level_search(std::size_t level);
+
+    HierarchicalGraph &hierarchical_graph;
+    std::size_t k;
+    GridPosition goal_pos;
+    SearchContext &context;
+    AbstractPathCache *path_cache;
+    KController *k_controller;
+    LevelSearchMemo *level_search_memo;
+    GridPosition current_start_pos;    // End of the path refined so far
+    std::size_t iteration = 0;         // Segments refined so far
+    std::vector<std::size_t> start_indices;    // Dense index of the node holding the start on each level
+    std::vector<std::size_t> goal_indices;     // Dense index of the node holding the goal on each level
+    std::unordered_set<std::size_t> constrained_nodes;
+    std::vector<std::size_t> segment;
+    std::vector<std::size_t> cached_path;
+    std::vector<std::size_t> parent_path;    // Truncated path on the level above the one being searched
+    std::size_t remaining_level = 0;
+    std::vector<std::size_t> remaining_path;    // Untruncated path last planned on the starting level
+    // Hops from the goal on each level by the dense index of the goal node, counted once needed
+    std::vector<std::unordered_map<std::size_t, std::vector<std::uint8_t>>> goal_hops;
+    SearchOutput search_output;
+    SearchStatus status = SearchStatus::InProgress;
+
+    std::optional<std::size_t> first_starting_level;    // Starting level of the first iteration if given
+
+    // Iteration in progress, kept when the budget runs out so the next call continues it
+    bool is_iterating = false;
+    std::size_t starting_level = 0;
+    std::size_t level_step = 0;            // Levels of the iteration done, counted down from the starting level
+    std::size_t current_goal_id = 0;       // Goal of the level being searched, the sub-goal below the starting level
+    bool is_reused = false;                // Whether the starting level path is kept from the previous iteration
+    std::size_t kept_begin = 0;            // Where the kept path starts in remaining_path
+    std::size_t first_level_search = 0;    // Level search the iteration starts at in search_output
+    std::optional<GridAStarSearch> grid_search;            // Grid search stopped by the budget
+    std::optional<AbstractAStarSearch> abstract_search;    // Abstract search stopped by the budget
+};
+
 /**
- * Perform PRA* search
+ * Perform PRA* search.
+ * Each iteration starts from the lowest level where the abstract start and goal are within STARTING_LEVEL_HOPS of each
+ * other, so short queries are searched on the grid alone. Every segment is refined before returning,
+ * PRAStarPathIterator refines them one at a time.
  * @param graph The graph to search over
  * @param k The K parameter for truncation for PRA*
  * @param start_pos The starting position
  * @param goal_pos The goal position
- * @return Results of search
+ * @param context Search workspace reused by every level search, defaults to the one owned by the calling thread
+ * @param budget Work allowed over all level searches, unlimited by default. When it runs out, the partial path holds
+ * the completed iterations followed by the partial grid path of the one in progress, if its grid search was reached.
+ * The search continues by calling again from its end, PRAStarPathIterator keeps the interrupted search instead.
+ * @param path_cache Cache of the abstract paths each iteration starts from, shared between queries, none by default.
+ * On a hit refinement starts from the cached path, the graph must not change without invalidating the cache.
+ * @param k_controller Picks the K of each iteration in place of k, learning from every query it is given to, none by
+ * default
+ * @param level_search_memo Abstract level searches shared with other queries, none by default. Searches found in it
+ * are reported as cache hits.
+ * @return Results of search, the path is given as layer 0 node IDs and each level search is kept in level_searches.
+ * The path is empty and its cost -1 if there is no path to the goal.
  */
 SearchOutput pra_star(HierarchicalGraph &graph, std::size_t k, const GridPosition &start_pos,
-                      const GridPosition &goal_pos);
+                      const GridPosition &goal_pos, SearchContext &context = get_thread_search_context(),
+                      const SearchBudget &budget = {}, AbstractPathCache *path_cache = nullptr,
+                      KController *k_controller = nullptr, LevelSearchMemo *level_search_memo = nullptr);
+
+/**
+ * Perform PRA* search for a batch of queries, such as a group of agents moving together.
+ * Queries are grouped by the level their first iteration starts from and the abstract start and goal nodes on it.
+ * Each abstract level search of a group is done once and shared by every query which would have done the same search,
+ * only the grid refinement is done per query. Every query gets the path pra_star would find for it.
+ * @param graph The graph to search over
+ * @param k The K parameter for truncation for PRA*
+ * @param queries Start and goal position of each query
+ * @param context Search workspace reused by every level search, defaults to the one owned by the calling thread
+ * @param path_cache Cache of the abstract paths each iteration starts from, shared between queries, none by default
+ * @return Results of search of each query in order, the level searches shared with an earlier query of its group are
+ * reported as cache hits and not counted in its expansions or duration
+ */
+std::vector<SearchOutput> pra_star_batch(HierarchicalGraph &graph, std::size_t k,
+                                         const std::vector<std::pair<GridPosition, GridPosition>> &queries,
+                                         SearchContext &context = get_thread_search_context(),
+                                         AbstractPathCache *path_cache = nullptr);
+
+/**
+ * Perform PRA* search with the refinement of the path spread over several threads.
+ * The path is planned once on the starting level without truncation, then split into windows of about the same
+ * number of hops which are refined down to the grid concurrently. Adjacent windows meet at the representative cell of
+ * the node between them, then each seam is searched again concurrently on the grid within the cells of the three nodes
+ * the windows overlap on. A seam never costs more than the windows joined at the shared cell, and the path only passes
+ * through that cell where nothing shorter crosses the overlap. With one thread, or a path too short to split, the path
+ * is refined as by PRA* with K as infinity, except each level searches toward the node holding the goal cell.
+ * @param graph The graph to search over, the constrained nodes of its starting level are cleared
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param num_threads Number of windows refined at once at most, the calling thread refines the first
+ * @param contexts Search workspaces to reuse, one per thread, resized as needed
+ * @return Results of search, the durations are wall clock time and the window of each level search is reported as its
+ * iteration, a seam as the iteration of the window after it. first_move_duration is the time until the first window
+ * is refined.
+ */
+SearchOutput pra_star_parallel(HierarchicalGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                               std::size_t num_threads, std::vector<SearchContext> &contexts);
 
 }    // namespace tpl_search
 
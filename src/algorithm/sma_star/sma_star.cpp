@@ -0,0 +1,390 @@
+// File: sma_star.cpp
+// Simplified memory-bounded A* (SMA*) search algorithm
+
+#include "sma_star.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <vector>
+
+#include "util/timer.h"
+
+namespace tpl_search {
+
+namespace {
+
+constexpr std::uint32_t NO_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+// Search node held in one of the slots of the tree
+template <typename CostT>
+struct TreeNode {
+    std::size_t index;
+    std::uint32_t parent_slot;
+    std::uint32_t num_children = 0;    // Children held in the tree, nodes with none are leaves
+    CostT g{};
+    CostT f{};              // Key on the open list, the smallest backed up f-value once expanded
+    CostT forgotten_f{};    // Smallest f-value of the dropped children
+    bool has_forgotten = false;
+    bool is_open = false;
+    bool is_dead = false;    // Expanded leaf whose children are all held more cheaply elsewhere
+};
+
+// Outcome of making room for a child
+enum class DropResult {
+    Dropped,       // A leaf was dropped
+    ChildWorse,    // Every leaf is better than the child
+    NoLeaf,        // The tree is a single path down to the node being expanded
+};
+
+// Open node ordered by f-value, deeper nodes first on ties
+template <typename CostT>
+struct OpenKey {
+    CostT f;
+    CostT g;
+    std::uint32_t slot;
+
+    bool operator<(const OpenKey &other) const {
+        if (f != other.f) {
+            return f < other.f;
+        }
+        if (g != other.g) {
+            return g > other.g;
+        }
+        return slot < other.slot;
+    }
+};
+
+// Search tree held in a fixed number of slots
+template <typename GraphT, typename HeuristicT, typename CostT>
+class BoundedSearchTree {
+public:
+    using Node = TreeNode<CostT>;
+
+    BoundedSearchTree(const GraphT &graph, const HeuristicT &heuristic, std::size_t max_nodes)
+        : graph(graph), heuristic(heuristic), max_nodes(max_nodes) {
+        nodes.reserve(max_nodes);
+        slots.reserve(max_nodes);
+    }
+
+    /**
+     * Search from the start until the goal is expanded
+     * @param start_index Dense index of the start node
+     * @param goal_index Dense index of the goal node
+     * @return Slot of the goal, NO_SLOT if no path was found within the cap
+     */
+    std::uint32_t search(std::size_t start_index, std::size_t goal_index) {
+        const std::uint32_t start_slot = allocate(start_index, NO_SLOT, CostT{});
+        push_open(start_slot, heuristic(start_index));
+        while (!open.empty()) {
+            const std::uint32_t slot = open.begin()->slot;
+            pop_open(slot);
+            if (nodes[slot].index == goal_index) {
+                return slot;
+            }
+            if (!expand(slot)) {
+                return NO_SLOT;
+            }
+        }
+        return NO_SLOT;
+    }
+
+    const Node &get_node(std::uint32_t slot) const {
+        return nodes[slot];
+    }
+
+    std::size_t get_expanded() const {
+        return expanded;
+    }
+
+    std::size_t get_generated() const {
+        return generated;
+    }
+
+    std::size_t get_peak_nodes() const {
+        return peak_nodes;
+    }
+
+private:
+    /**
+     * Generate the children of a node not held in the tree, or held with a worse path
+     * @param slot Slot of the node, off the open list
+     * @return False if the cap is too small to hold a child
+     */
+    bool expand(std::uint32_t slot) {
+        ++expanded;
+        expanding_slot = slot;
+        // Every child missing from the tree is generated again, so the dropped ones are accounted for
+        nodes[slot].has_forgotten = false;
+        bool has_room = true;
+        const CostT g = nodes[slot].g;
+        // Once children have been dropped the key is backed up from them, a bound regenerated children inherit
+        const CostT f = nodes[slot].f;
+        graph.for_each_neighbour(nodes[slot].index, [&](std::size_t child_index, const CostT &edge_cost) {
+            if (!has_room) {
+                return;
+            }
+            const CostT child_g = g + edge_cost;
+            const CostT child_f = std::max(child_g + heuristic(child_index), f);
+            const auto it = slots.find(child_index);
+            if (it != slots.end()) {
+                // Nodes with a better path are moved under this node and searched again, their subtrees are
+                // corrected as they are expanded
+                const std::uint32_t child_slot = it->second;
+                if (!(child_g < nodes[child_slot].g)) {
+                    return;
+                }
+                if (nodes[child_slot].is_open) {
+                    pop_open(child_slot);
+                }
+                detach(child_slot);
+                nodes[child_slot].parent_slot = slot;
+                nodes[child_slot].g = child_g;
+                nodes[child_slot].is_dead = false;
+                ++nodes[slot].num_children;
+                push_open(child_slot, child_f);
+                ++generated;
+                return;
+            }
+            if (nodes.size() - free_slots.size() >= max_nodes) {
+                const DropResult result = drop_worst_leaf(child_f);
+                if (result == DropResult::NoLeaf) {
+                    has_room = false;
+                    return;
+                }
+                // Children no better than every leaf held are forgotten straight away
+                if (result == DropResult::ChildWorse) {
+                    forget(slot, child_f);
+                    ++generated;
+                    return;
+                }
+            }
+            const std::uint32_t child_slot = allocate(child_index, slot, child_g);
+            ++nodes[slot].num_children;
+            push_open(child_slot, child_f);
+            ++generated;
+        });
+        expanding_slot = NO_SLOT;
+        if (!has_room) {
+            return false;
+        }
+
+        // Children dropped while expanding are searched again from this node
+        if (nodes[slot].has_forgotten) {
+            push_open(slot, nodes[slot].forgotten_f);
+        } else {
+            mark_if_dead(slot);
+        }
+        return true;
+    }
+
+    /**
+     * Make room for a child of the node being expanded. Dead leaves are dropped first, as they lead nowhere new.
+     * Otherwise the open leaf with the largest f-value is dropped, shallower leaves first on ties, and its f-value is
+     * backed up into its parent. Sibling leaves are only dropped for a child with a smaller f-value, so a plateau of
+     * equal f-values isn't regenerated forever.
+     * @param child_f Key of the child to make room for
+     * @return Whether a leaf was dropped, or why not
+     */
+    DropResult drop_worst_leaf(const CostT &child_f) {
+        while (!dead_slots.empty()) {
+            const std::uint32_t slot = dead_slots.back();
+            dead_slots.pop_back();
+            // Dead nodes which have since been moved or released are skipped
+            if (nodes[slot].is_dead) {
+                const std::uint32_t parent_slot = nodes[slot].parent_slot;
+                release(slot);
+                --nodes[parent_slot].num_children;
+                mark_if_dead(parent_slot);
+                return DropResult::Dropped;
+            }
+        }
+        bool has_leaf = false;
+        for (auto it = open.rbegin(); it != open.rend(); ++it) {
+            const Node &node = nodes[it->slot];
+            if (node.num_children > 0 || node.parent_slot == NO_SLOT) {
+                continue;
+            }
+            has_leaf = true;
+            if (node.f < child_f) {
+                return DropResult::ChildWorse;
+            }
+            if (child_f < node.f || node.parent_slot != expanding_slot) {
+                drop_leaf(it->slot);
+                return DropResult::Dropped;
+            }
+        }
+        return has_leaf ? DropResult::ChildWorse : DropResult::NoLeaf;
+    }
+
+    // Drop an open leaf, its parent stands in for it on the open list
+    void drop_leaf(std::uint32_t slot) {
+        const std::uint32_t parent_slot = nodes[slot].parent_slot;
+        const CostT f = nodes[slot].f;
+        pop_open(slot);
+        release(slot);
+
+        --nodes[parent_slot].num_children;
+        forget(parent_slot, f);
+    }
+
+    // Back up the f-value of a child left out of the tree, the node stands in for it on the open list
+    void forget(std::uint32_t slot, const CostT &f) {
+        Node &node = nodes[slot];
+        if (!node.has_forgotten || f < node.forgotten_f) {
+            node.forgotten_f = f;
+            node.has_forgotten = true;
+        }
+        // The node being expanded is put back once its expansion is done
+        if (node.is_open) {
+            if (node.forgotten_f < node.f) {
+                pop_open(slot);
+                push_open(slot, node.forgotten_f);
+            }
+        } else if (slot != expanding_slot) {
+            push_open(slot, node.forgotten_f);
+        }
+    }
+
+    // Remove a node from under its parent
+    void detach(std::uint32_t slot) {
+        const std::uint32_t parent_slot = nodes[slot].parent_slot;
+        if (parent_slot != NO_SLOT) {
+            --nodes[parent_slot].num_children;
+            mark_if_dead(parent_slot);
+        }
+    }
+
+    // Mark an expanded node without children or dropped children as dead, it is kept until room is needed so the
+    // nodes it was expanded into aren't searched again
+    void mark_if_dead(std::uint32_t slot) {
+        Node &node = nodes[slot];
+        if (slot == expanding_slot || node.is_open || node.is_dead || node.num_children > 0 || node.has_forgotten ||
+            node.parent_slot == NO_SLOT) {
+            return;
+        }
+        node.is_dead = true;
+        dead_slots.push_back(slot);
+    }
+
+    std::uint32_t allocate(std::size_t index, std::uint32_t parent_slot, const CostT &g) {
+        std::uint32_t slot;
+        if (free_slots.empty()) {
+            slot = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back({index, parent_slot});
+        } else {
+            slot = free_slots.back();
+            free_slots.pop_back();
+            nodes[slot] = {index, parent_slot};
+        }
+        nodes[slot].g = g;
+        slots[index] = slot;
+        peak_nodes = std::max(peak_nodes, nodes.size() - free_slots.size());
+        return slot;
+    }
+
+    void release(std::uint32_t slot) {
+        slots.erase(nodes[slot].index);
+        nodes[slot].is_dead = false;
+        free_slots.push_back(slot);
+    }
+
+    void push_open(std::uint32_t slot, const CostT &f) {
+        nodes[slot].f = f;
+        nodes[slot].is_open = true;
+        open.insert({f, nodes[slot].g, slot});
+    }
+
+    void pop_open(std::uint32_t slot) {
+        open.erase({nodes[slot].f, nodes[slot].g, slot});
+        nodes[slot].is_open = false;
+    }
+
+    const GraphT &graph;
+    const HeuristicT &heuristic;
+    std::size_t max_nodes;
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> free_slots;
+    std::vector<std::uint32_t> dead_slots;                    // Dead nodes, may hold stale entries
+    absl::flat_hash_map<std::size_t, std::uint32_t> slots;    // Slot of each node held, by dense index
+    std::set<OpenKey<CostT>> open;                            // Ordered both ways, the back holds the leaves to drop
+    std::uint32_t expanding_slot = NO_SLOT;    // Node being expanded, off the open list until its expansion is done
+    std::size_t expanded = 0;
+    std::size_t generated = 0;
+    std::size_t peak_nodes = 0;
+};
+
+}    // namespace
+
+template <typename GraphT, typename HeuristicT, typename CostT>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput sma_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                             const HeuristicT &heuristic, std::size_t max_nodes) {
+    if (max_nodes == 0) {
+        max_nodes = graph.num_nodes();
+    }
+    max_nodes = std::min<std::size_t>(max_nodes, NO_SLOT);
+
+    // Init
+    ThreadTimer timer;
+    timer.start();
+
+    BoundedSearchTree<GraphT, HeuristicT, CostT> tree(graph, heuristic, max_nodes);
+    const std::uint32_t goal_slot = tree.search(start_index, goal_index);
+    const std::size_t expanded = tree.get_expanded();
+    const std::size_t generated = tree.get_generated();
+    if (goal_slot == NO_SLOT) {
+#ifdef DEBUG
+        std::cerr << "Exhausted search space or node cap, no solution found" << std::endl;
+#endif
+        SearchOutput search_output{expanded, generated, timer.get_duration(), -1, -1, {}, {}};
+        search_output.peak_nodes = tree.get_peak_nodes();
+        return search_output;
+    }
+
+    // Every ancestor of a node held is held as well
+    std::vector<std::size_t> path;
+    for (std::uint32_t slot = goal_slot; slot != NO_SLOT; slot = tree.get_node(slot).parent_slot) {
+        path.push_back(graph.get_node_id(tree.get_node(slot).index));
+    }
+    std::reverse(path.begin(), path.end());
+
+    double duration = timer.get_duration();
+    SearchOutput search_output{expanded, generated, duration, duration, cost_to_double(tree.get_node(goal_slot).g),
+                               path, {}};
+    search_output.peak_nodes = tree.get_peak_nodes();
+#ifdef DEBUG
+    std::cout << "Solution found. Solution length: " << search_output.path_node_ids.size()
+              << ", solution cost: " << search_output.path_cost << ", Expanded: " << expanded
+              << ", Generated: " << generated << ", Peak nodes: " << search_output.peak_nodes << ", Time: " << duration
+              << "s" << std::endl;
+#endif
+    return search_output;
+}
+
+template SearchOutput sma_star_search<GridGraphView, GridOctileHeuristic, OctileCost>(const GridGraphView &,
+                                                                                      std::size_t, std::size_t,
+                                                                                      const GridOctileHeuristic &,
+                                                                                      std::size_t);
+template SearchOutput sma_star_search<AbstractGraphView, AbstractOctileHeuristic, double>(
+    const AbstractGraphView &, std::size_t, std::size_t, const AbstractOctileHeuristic &, std::size_t);
+
+SearchOutput sma_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                      std::size_t max_nodes) {
+    const std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(start_pos));
+    const std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(goal_pos));
+    // Grid layers are searched with exact octile arithmetic
+    if (graph.is_grid_graph()) {
+        const GridGraphView view(graph);
+        return sma_star_search(view, start_index, goal_index, GridOctileHeuristic(view, goal_index), max_nodes);
+    }
+    const AbstractGraphView view(graph);
+    return sma_star_search(view, start_index, goal_index, AbstractOctileHeuristic(view, goal_index), max_nodes);
+}
+
+}    // namespace tpl_search
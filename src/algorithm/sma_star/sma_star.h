@@ -0,0 +1,50 @@
+// File: sma_star.h
+// Simplified memory-bounded A* (SMA*) search algorithm
+
+#ifndef PRA_ALGORITHM_SMA_STAR_H
+#define PRA_ALGORITHM_SMA_STAR_H
+
+#include "algorithm/common/graph.h"
+#include "algorithm/common/graph_view.h"
+#include "algorithm/common/search_concepts.h"
+#include "algorithm/common/search_output.h"
+
+namespace tpl_search {
+
+/**
+ * Perform SMA* search over dense node indices, holding at most max_nodes search nodes at once.
+ * Once the cap is reached, the open leaf with the largest f-value is dropped to make room and its f-value is backed up
+ * into its parent, which is put back on the open list so the dropped part of the tree is regenerated only if it turns
+ * out to be needed. Children no better than every leaf held are backed up into their parent without being added.
+ * Expanded nodes whose children are all held more cheaply elsewhere are kept until room is needed, so they aren't
+ * regenerated, and are the first to be dropped.
+ * @note Storage is allocated per query and released at the end, so unlike the other searches no workspace is kept.
+ * The path is optimal as long as the cap holds the nodes of the optimal path. On grids with many equal f-values the
+ * number of expansions grows quickly once the cap is well below the nodes A* would generate.
+ * Only the grid and abstract graph views with their octile heuristics are instantiated in sma_star.cpp
+ * @param graph The graph to search over
+ * @param start_index Dense index of the start node
+ * @param goal_index Dense index of the goal node
+ * @param heuristic Heuristic estimating the cost to the goal node, must be consistent
+ * @param max_nodes Most search nodes held at once, 0 for one per graph node
+ * @return Results of search along with the peak node count, no path if the search runs out of room along a single path
+ */
+template <typename GraphT, typename HeuristicT, typename CostT = typename GraphT::CostType>
+    requires SearchGraph<GraphT, CostT> && SearchHeuristic<HeuristicT, CostT>
+SearchOutput sma_star_search(const GraphT &graph, std::size_t start_index, std::size_t goal_index,
+                             const HeuristicT &heuristic, std::size_t max_nodes);
+
+/**
+ * Perform SMA* search
+ * @param graph The graph to search over
+ * @param start_pos The starting position
+ * @param goal_pos The goal position
+ * @param max_nodes Most search nodes held at once, 0 for one per graph node
+ * @return Results of search
+ */
+SearchOutput sma_star(const FlatGraph &graph, const GridPosition &start_pos, const GridPosition &goal_pos,
+                      std::size_t max_nodes);
+
+}    // namespace tpl_search
+
+#endif    // PRA_ALGORITHM_SMA_STAR_H
@@ -6,10 +6,15 @@
 #include <absl/flags/usage.h>
 #include <absl/strings/str_cat.h>
 
+#include <thread>
+
 #include "algorithm/common/graph_generator.h"
+#include "algorithm/common/landmarks.h"
+#include "algorithm/jps/jump_table.h"
 #include "util/file_util.h"
 
 ABSL_FLAG(std::string, map_path, "/opt/", "Full path for the map");
+ABSL_FLAG(std::size_t, threads, std::thread::hardware_concurrency(), "Number of threads to build the jump table with");
 
 using namespace tpl_search;
 
@@ -21,6 +26,12 @@ int main(int argc, char** argv) {
     FlatGraph flat_graph = load_flat_graph(map_path, true);
     flat_graph.save(map_to_flat_graph_path(map_path));
 
+    LandmarkTable landmarks = load_landmarks(map_path, flat_graph, true);
+    landmarks.save(map_to_landmarks_path(map_path));
+
     HierarchicalGraph hierarchical_graph = load_hierarchical_graph(map_path, true);
     hierarchical_graph.save(map_to_hierarchical_graph_path(map_path));
+
+    JumpTable jump_table = load_jump_table(map_path, true, absl::GetFlag(FLAGS_threads));
+    jump_table.save(map_to_jump_table_path(map_path));
 }
@@ -12,6 +12,13 @@ ABSL_FLAG(std::string, scenario_path, "/opt/", "Full path for the scenario");
 ABSL_FLAG(std::string, algorithm, "pra_star", "Search algorithm to run");
 ABSL_FLAG(std::size_t, k, 0, "K parameter for PRA*, use 0 as infinity");
 ABSL_FLAG(std::string, export_path, "/opt/", "Base directory for saved metrics");
+ABSL_FLAG(std::size_t, threads, 1, "Number of threads for parallel search algorithms");
+ABSL_FLAG(std::size_t, max_nodes, 0, "Most search nodes held at once by memory-bounded search, use 0 as infinity");
+ABSL_FLAG(std::size_t, path_cache_size, 0, "Abstract paths cached across PRA* queries, use 0 to disable");
+ABSL_FLAG(std::size_t, target_expanded, 0,
+          "Expansions each PRA* iteration should fit in, K is then picked per iteration, use 0 for a fixed --k");
+ABSL_FLAG(double, target_seconds, 0,
+          "CPU seconds each PRA* iteration should fit in, K is then picked per iteration, use 0 for a fixed --k");
 
 using namespace tpl_search;
 
@@ -22,7 +29,12 @@ int main(int argc, char** argv) {
     std::string algorithm = absl::GetFlag(FLAGS_algorithm);
     std::size_t k = absl::GetFlag(FLAGS_k);
     std::string export_path = absl::GetFlag(FLAGS_export_path);
+    std::size_t num_threads = absl::GetFlag(FLAGS_threads);
+    std::size_t max_nodes = absl::GetFlag(FLAGS_max_nodes);
+    std::size_t path_cache_size = absl::GetFlag(FLAGS_path_cache_size);
+    SearchBudget k_target{absl::GetFlag(FLAGS_target_expanded), absl::GetFlag(FLAGS_target_seconds)};
 
     std::vector<Scenario> scenarios = load_scenarios(scenario_path);
-    algorithm_runner(scenario_path, scenarios, algorithm, k, export_path);
+    algorithm_runner(scenario_path, scenarios, algorithm, k, export_path, num_threads, max_nodes, path_cache_size,
+                     k_target);
 }
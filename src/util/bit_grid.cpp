@@ -0,0 +1,26 @@
+// File: bit_grid.cpp
+// Grid map packed into bits for word at a time scanning
+
+#include "bit_grid.h"
+
+namespace tpl_search {
+
+BitGrid::BitGrid(const Map &map)
+    : width(map.width),
+      height(map.height),
+      words_per_row((map.width + 63) / 64),
+      words_per_column((map.height + 63) / 64),
+      rows(words_per_row * map.height, 0),
+      columns(words_per_column * map.width, 0) {
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            if (!map.grid_map[y * width + x]) {
+                continue;
+            }
+            rows[y * words_per_row + x / 64] |= std::uint64_t{1} << (x % 64);
+            columns[x * words_per_column + y / 64] |= std::uint64_t{1} << (y % 64);
+        }
+    }
+}
+
+}    // namespace tpl_search
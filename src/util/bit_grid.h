@@ -0,0 +1,91 @@
+// File: bit_grid.h
+// Grid map packed into bits for word at a time scanning
+
+#ifndef PRA_UTIL_BIT_GRID_H
+#define PRA_UTIL_BIT_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "map.h"
+
+namespace tpl_search {
+
+// Grid map with one bit per cell, set if the cell is pathable.
+// Cells are stored row by row and also column by column, so scans along either axis read whole words. Coordinates
+// outside of the map read as blocked, which bounds every scan.
+class BitGrid {
+public:
+    BitGrid() = default;
+    explicit BitGrid(const Map &map);
+
+    std::size_t get_width() const {
+        return width;
+    }
+
+    std::size_t get_height() const {
+        return height;
+    }
+
+    /**
+     * Check if a cell is pathable
+     * @param x Column of the cell, may be outside of the map
+     * @param y Row of the cell, may be outside of the map
+     * @return True if the cell is in the map and pathable, false otherwise
+     */
+    bool is_free(std::ptrdiff_t x, std::ptrdiff_t y) const {
+        return (row_bits(y, x) & 1) != 0;
+    }
+
+    /**
+     * Get the pathable flags of 64 consecutive cells of a row
+     * @param y Row to read
+     * @param x Column of the first cell
+     * @return Bit i is set if cell (x + i, y) is pathable
+     */
+    std::uint64_t row_bits(std::ptrdiff_t y, std::ptrdiff_t x) const {
+        if (y < 0 || y >= static_cast<std::ptrdiff_t>(height)) {
+            return 0;
+        }
+        return read_bits(rows, static_cast<std::size_t>(y) * words_per_row, words_per_row, x);
+    }
+
+    /**
+     * Get the pathable flags of 64 consecutive cells of a column
+     * @param x Column to read
+     * @param y Row of the first cell
+     * @return Bit i is set if cell (x, y + i) is pathable
+     */
+    std::uint64_t column_bits(std::ptrdiff_t x, std::ptrdiff_t y) const {
+        if (x < 0 || x >= static_cast<std::ptrdiff_t>(width)) {
+            return 0;
+        }
+        return read_bits(columns, static_cast<std::size_t>(x) * words_per_column, words_per_column, y);
+    }
+
+private:
+    // Read 64 bits of a line starting at an arbitrary offset, bits outside of the line are zero
+    static std::uint64_t read_bits(const std::vector<std::uint64_t> &data, std::size_t line_start,
+                                   std::size_t num_words, std::ptrdiff_t offset) {
+        if (offset < 0) {
+            return offset <= -64 ? 0 : read_bits(data, line_start, num_words, 0) << -offset;
+        }
+        const std::size_t word = static_cast<std::size_t>(offset) / 64;
+        const std::size_t bit = static_cast<std::size_t>(offset) % 64;
+        const std::uint64_t low = word < num_words ? data[line_start + word] >> bit : 0;
+        const std::uint64_t high = bit != 0 && word + 1 < num_words ? data[line_start + word + 1] << (64 - bit) : 0;
+        return low | high;
+    }
+
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::size_t words_per_row = 0;
+    std::size_t words_per_column = 0;
+    std::vector<std::uint64_t> rows;       // Row major bits
+    std::vector<std::uint64_t> columns;    // Column major bits
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_UTIL_BIT_GRID_H
@@ -0,0 +1,128 @@
+// File: bucket_queue.h
+// Two-level bucket queue for monotone integer keys
+
+#ifndef PRA_UTIL_BUCKET_QUEUE_H
+#define PRA_UTIL_BUCKET_QUEUE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace tpl_search {
+
+// Bucket queue over integer keys, for use when popped keys are non-decreasing.
+// The first level is a vector of buckets each covering 2^bucket_shift consecutive keys, the second level is a small
+// binary heap inside each bucket ordered by CompareT, which must agree with the key ordering and can break ties.
+// The cursor to the lowest non-empty bucket only moves forward, so pushes and pops are constant time apart from the
+// in-bucket heap. Keys below the cursor are placed into the cursor bucket, which keeps the pop order correct.
+template <typename T, typename CompareT>
+class BucketQueue {
+public:
+    BucketQueue(unsigned int bucket_shift = 0) : bucket_shift(bucket_shift) {}
+
+    /**
+     * Insert a value
+     * @param t The value to insert
+     * @param key The integer key of the value
+     */
+    void push(const T &t, std::uint64_t key) {
+        const std::uint64_t bucket_key = key >> bucket_shift;
+        if (num_elements == 0) {
+            // All buckets are empty, so the queue can be rebased to this key
+            base_key = bucket_key;
+            cursor = 0;
+            used_end = 0;
+        }
+        std::size_t idx = bucket_key < base_key + cursor ? cursor : static_cast<std::size_t>(bucket_key - base_key);
+        if (idx >= buckets.size()) {
+            buckets.resize(std::max(idx + 1, 2 * buckets.size()));
+        }
+        std::vector<T> &bucket = buckets[idx];
+        bucket.push_back(t);
+        std::push_heap(bucket.begin(), bucket.end(), heap_comper);
+        used_end = std::max(used_end, idx + 1);
+        ++num_elements;
+    }
+
+    /**
+     * Get a reference to the top element
+     * @return The top element
+     */
+    const T &top() {
+        assert(!empty());
+        advance();
+        return buckets[cursor].front();
+    }
+
+    /**
+     * Removes the top element
+     * @note If the queue is empty, then no change occurs
+     */
+    void pop() {
+        if (empty()) {
+            return;
+        }
+        advance();
+        std::vector<T> &bucket = buckets[cursor];
+        std::pop_heap(bucket.begin(), bucket.end(), heap_comper);
+        bucket.pop_back();
+        --num_elements;
+    }
+
+    /**
+     * Remove all elements, keeping the allocated storage
+     */
+    void clear() {
+        for (std::size_t i = cursor; i < used_end; ++i) {
+            buckets[i].clear();
+        }
+        num_elements = 0;
+        cursor = 0;
+        used_end = 0;
+    }
+
+    /**
+     * Check if the queue is empty
+     * @return True if the queue is empty, false otherwise
+     */
+    bool empty() const {
+        return num_elements == 0;
+    }
+
+    /**
+     * Get the number of elements stored in the queue
+     * @return The number of elements stored in the queue
+     */
+    std::size_t size() const {
+        return num_elements;
+    }
+
+private:
+    // Heap comparator, the std heap functions keep the largest element on top
+    struct HeapCompare {
+        bool operator()(const T &left, const T &right) const {
+            return comper(right, left);
+        }
+        CompareT comper;
+    };
+
+    // Move the cursor to the first non-empty bucket
+    void advance() {
+        while (buckets[cursor].empty()) {
+            ++cursor;
+        }
+    }
+
+    unsigned int bucket_shift;
+    HeapCompare heap_comper;
+    std::vector<std::vector<T>> buckets;    // Bucket storage, index is the bucket key relative to base_key
+    std::uint64_t base_key = 0;             // Bucket key of the first bucket
+    std::size_t cursor = 0;                 // Lowest bucket which may be non-empty
+    std::size_t used_end = 0;               // One past the highest bucket used since the last clear
+    std::size_t num_elements = 0;
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_UTIL_BUCKET_QUEUE_H
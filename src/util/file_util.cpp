@@ -52,4 +52,16 @@ std::filesystem::path map_to_hierarchical_graph_path(const std::filesystem::path
     return hierarchical_graph_path.replace_extension(".hierarchical_graph.nop");
 }
 
+std::filesystem::path map_to_jump_table_path(const std::filesystem::path &map_path) {
+    // ./AR00011SR.map to ./AR00011SR.jump_table.nop
+    std::filesystem::path jump_table_path = map_path;
+    return jump_table_path.replace_extension(".jump_table.nop");
+}
+
+std::filesystem::path map_to_landmarks_path(const std::filesystem::path &map_path) {
+    // ./AR00011SR.map to ./AR00011SR.landmarks.nop
+    std::filesystem::path landmarks_path = map_path;
+    return landmarks_path.replace_extension(".landmarks.nop");
+}
+
 }    // namespace tpl_search
@@ -43,6 +43,20 @@ std::filesystem::path map_to_flat_graph_path(const std::filesystem::path &map_pa
  */
 std::filesystem::path map_to_hierarchical_graph_path(const std::filesystem::path &map_path);
 
+/**
+ * Convert map path to JPS+ jump table path
+ * @param map_path Path of map file
+ * @return File path to corresponding jump table
+ */
+std::filesystem::path map_to_jump_table_path(const std::filesystem::path &map_path);
+
+/**
+ * Convert map path to landmark table path
+ * @param map_path Path of map file
+ * @return File path to corresponding landmark table
+ */
+std::filesystem::path map_to_landmarks_path(const std::filesystem::path &map_path);
+
 }    // namespace tpl_search
 
 #endif    // PRA_UTIL_FILE_H
@@ -0,0 +1,69 @@
+// File: mpsc_queue.h
+// Lock-free multiple producer single consumer queue
+
+#ifndef PRA_UTIL_MPSC_QUEUE_H
+#define PRA_UTIL_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace tpl_search {
+
+// Unbounded linked list queue after Dmitry Vyukov's MPSC design.
+// Any thread may push, each push is a single atomic exchange. Only one thread may pop, which never writes to memory
+// shared with the producers. A pop can miss an element whose push is still in progress, which shows up on a later pop.
+template <typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() : head(new QueueNode()), tail(head.load(std::memory_order_relaxed)) {}
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    ~MPSCQueue() {
+        T value;
+        while (try_pop(value)) {
+        }
+        delete tail;
+    }
+
+    /**
+     * Add an element to the back of the queue, safe to call from any thread
+     * @param value The element to add
+     */
+    void push(T value) {
+        QueueNode *node = new QueueNode{{nullptr}, std::move(value)};
+        QueueNode *previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * Remove the element at the front of the queue, only to be called from the consuming thread
+     * @param value Storage to move the element into
+     * @return True if an element was removed, false if the queue is empty
+     */
+    bool try_pop(T &value) {
+        QueueNode *next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        // The next node becomes the new stub, its value is moved out
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+private:
+    struct QueueNode {
+        std::atomic<QueueNode *> next{nullptr};
+        T value{};
+    };
+
+    alignas(64) std::atomic<QueueNode *> head;    // Last pushed node, shared by the producers
+    alignas(64) QueueNode *tail;                  // Stub node before the front, owned by the consumer
+};
+
+}    // namespace tpl_search
+
+#endif    // PRA_UTIL_MPSC_QUEUE_H
@@ -4,6 +4,7 @@
 #ifndef PRA_UTIL_TIMER_H
 #define PRA_UTIL_TIMER_H
 
+#include <chrono>
 #include <ctime>
 
 namespace tpl_search {
@@ -83,6 +84,23 @@ private:
     struct timespec start_time;
 };
 
+// Measures elapsed real time, for searches spread over several threads
+class WallTimer {
+public:
+    WallTimer() = default;
+
+    void start() {
+        start_time = std::chrono::steady_clock::now();
+    }
+
+    double get_duration() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_time;
+};
+
 }    // namespace tpl_search
 
 #endif    // PRA_UTIL_TIMER_H
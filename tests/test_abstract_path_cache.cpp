@@ -0,0 +1,102 @@
+// File: test_abstract_path_cache.cpp
+// Test the abstract path cache on its own, shared between threads and used by PRA*
+
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/pra_star/abstract_path_cache.h"
+#include "algorithm/pra_star/pra_star.h"
+#include "test_macros.h"
+#include "test_maps.h"
+
+using namespace tpl_search;
+
+int main() {
+    {
+        // Least recently used paths are evicted, reversed queries are found and invalidation drops paths
+        AbstractPathCache cache(2);
+        std::vector<std::size_t> path;
+        cache.insert(1, {1, 2, 3});
+        cache.insert(1, {4, 5});
+        REQUIRE_TRUE(cache.find(1, 1, 3, path));
+        REQUIRE_TRUE(path == std::vector<std::size_t>({1, 2, 3}));
+        REQUIRE_TRUE(cache.find(1, 3, 1, path));
+        REQUIRE_TRUE(path == std::vector<std::size_t>({3, 2, 1}));
+        REQUIRE_FALSE(cache.find(2, 1, 3, path));
+        cache.insert(1, {6, 7});
+        REQUIRE_EQUAL(cache.size(), 2u);
+        REQUIRE_FALSE(cache.find(1, 4, 5, path));
+        REQUIRE_TRUE(cache.find(1, 6, 7, path));
+        REQUIRE_EQUAL(cache.get_hits(), 3u);
+        REQUIRE_EQUAL(cache.get_misses(), 2u);
+
+        cache.invalidate_node(1, 2);
+        REQUIRE_EQUAL(cache.size(), 1u);
+        REQUIRE_FALSE(cache.find(1, 1, 3, path));
+        cache.invalidate();
+        REQUIRE_EQUAL(cache.size(), 0u);
+        REQUIRE_FALSE(cache.find(1, 6, 7, path));
+    }
+    {
+        // Every lookup is counted once and the capacity holds while threads share the cache
+        constexpr std::size_t NUM_THREADS = 4;
+        constexpr std::size_t NUM_LOOKUPS = 10000;
+        AbstractPathCache cache(64);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&cache, t]() {
+                std::vector<std::size_t> path;
+                for (std::size_t i = 0; i < NUM_LOOKUPS; ++i) {
+                    // Fewer distinct queries than the capacity, so repeated ones are hits
+                    const std::size_t start_id = (i + t) % 8;
+                    const std::size_t goal_id = 100 + (i * 3) % 4;
+                    if (!cache.find(1, start_id, goal_id, path)) {
+                        cache.insert(1, {start_id, goal_id});
+                    } else if (path.front() != start_id || path.back() != goal_id) {
+                        std::cerr << "Wrong path for " << start_id << " to " << goal_id << std::endl;
+                        std::exit(1);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        REQUIRE_EQUAL(cache.get_hits() + cache.get_misses(), NUM_THREADS * NUM_LOOKUPS);
+        REQUIRE_TRUE(cache.get_hits() > 0);
+        REQUIRE_TRUE(cache.size() <= 64);
+    }
+    {
+        // PRA* finds the same paths through the cache, without searching the starting level again
+        const std::filesystem::path map_path =
+            std::filesystem::temp_directory_path() / "test_abstract_path_cache" / "walls.map";
+        write_wall_map(map_path);
+        HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+        std::filesystem::remove_all(map_path.parent_path());
+        SearchContext context;
+        AbstractPathCache cache;
+
+        const std::vector<std::pair<GridPosition, GridPosition>> queries{
+            {{0, 0}, {MAP_SIZE - 1, MAP_SIZE - 1}},
+            {{MAP_SIZE - 1, 0}, {0, MAP_SIZE - 1}},
+            {{0, MAP_SIZE / 2}, {MAP_SIZE - 1, MAP_SIZE / 2}},
+        };
+        for (const auto &[start_pos, goal_pos] : queries) {
+            for (const std::size_t k : {0, 4}) {
+                SearchOutput uncached_output = pra_star(hierarchical_graph, k, start_pos, goal_pos, context);
+                SearchOutput first_output =
+                    pra_star(hierarchical_graph, k, start_pos, goal_pos, context, {}, &cache);
+                SearchOutput second_output =
+                    pra_star(hierarchical_graph, k, start_pos, goal_pos, context, {}, &cache);
+                REQUIRE_TRUE(first_output.path_node_ids == uncached_output.path_node_ids);
+                REQUIRE_TRUE(second_output.path_node_ids == uncached_output.path_node_ids);
+                REQUIRE_NEAR(second_output.path_cost, uncached_output.path_cost, 1e-5);
+                REQUIRE_TRUE(second_output.expanded < uncached_output.expanded);
+            }
+        }
+        REQUIRE_TRUE(cache.get_hits() > 0);
+    }
+}
@@ -0,0 +1,76 @@
+// File: test_abstraction_heuristic.cpp
+// Test A* guided by abstract layer distances (HA*) against A* with the octile heuristic
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+#include "algorithm/a_star/a_star.h"
+#include "algorithm/common/abstraction_heuristic.h"
+#include "algorithm/common/graph_generator.h"
+#include "test_macros.h"
+#include "test_maps.h"
+
+using namespace tpl_search;
+
+int main() {
+    const std::filesystem::path map_path =
+        std::filesystem::temp_directory_path() / "test_abstraction_heuristic" / "walls.map";
+    write_wall_map(map_path);
+    HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+    std::filesystem::remove_all(map_path.parent_path());
+    const FlatGraph &graph = hierarchical_graph.get_layer(0);
+    const GridGraphView view(graph);
+    HomomorphicAbstraction abstraction(hierarchical_graph);
+
+    // Queries between open cells spread over the map
+    std::vector<std::pair<std::size_t, std::size_t>> queries;
+    for (std::size_t i = 0; i < 200; ++i) {
+        queries.emplace_back((i * 7919) % graph.num_nodes(), (i * 104729 + 13) % graph.num_nodes());
+    }
+    {
+        // Each grid node maps to the abstract node representing its cell
+        const FlatGraph &layer = hierarchical_graph.get_layer(HomomorphicAbstraction::DEFAULT_LEVEL);
+        REQUIRE_EQUAL(abstraction.num_abstract_nodes(), layer.num_nodes());
+        for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+            const GraphNode &abstract_node = layer.get_all_nodes()[abstraction.get_abstract_index(index)];
+            const GridPosition position = view.get_position(index);
+            REQUIRE_TRUE(std::find(abstract_node.represented_positions.begin(),
+                                   abstract_node.represented_positions.end(),
+                                   position) != abstract_node.represented_positions.end());
+        }
+    }
+    {
+        // The heuristic is consistent, never below the octile distance and zero at the goal
+        SearchWorkspace<OctileCost> workspace;
+        for (std::size_t i = 0; i < queries.size(); i += 20) {
+            const std::size_t goal_index = queries[i].second;
+            const AbstractionHeuristic heuristic(view, abstraction, goal_index, workspace);
+            const GridOctileHeuristic octile(view, goal_index);
+            REQUIRE_TRUE(heuristic(goal_index) == OctileCost{});
+            for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+                REQUIRE_TRUE(!(heuristic(index) < octile(index)));
+                view.for_each_neighbour(index, [&](std::size_t neighbour_index, const OctileCost &edge_cost) {
+                    REQUIRE_TRUE(!(edge_cost + heuristic(neighbour_index) < heuristic(index)));
+                });
+            }
+        }
+    }
+    {
+        // Same costs as A* with the octile heuristic, with fewer expansions
+        SearchContext context;
+        std::size_t octile_expanded = 0;
+        std::size_t abstraction_expanded = 0;
+        for (const auto &[start_index, goal_index] : queries) {
+            const GridPosition start_pos = view.get_position(start_index);
+            const GridPosition goal_pos = view.get_position(goal_index);
+            SearchOutput octile_output = a_star(graph, start_pos, goal_pos, context);
+            SearchOutput search_output = a_star(graph, abstraction, start_pos, goal_pos, context);
+            REQUIRE_NEAR(search_output.path_cost, octile_output.path_cost, 1e-5);
+            octile_expanded += octile_output.expanded;
+            abstraction_expanded += search_output.expanded;
+        }
+        REQUIRE_TRUE(abstraction_expanded < octile_expanded);
+    }
+}
@@ -0,0 +1,57 @@
+// File: test_ara_star.cpp
+// Test ARA* on known optimal paths
+
+#include <filesystem>
+#include <iostream>
+
+#include "algorithm/ara_star/ara_star.h"
+#include "algorithm/common/graph_generator.h"
+#include "test_macros.h"
+#include "util/file_util.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path scenario_path(__FILE__);
+    scenario_path = scenario_path.replace_filename("battleground.map.scen");
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    {
+        // Solutions improve until optimal, each within its bound of the optimal cost
+        SearchContext context;
+        for (std::size_t scenario_number : {0, 500, 1000, 1328}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            SearchOutput search_output =
+                ara_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, {}, context);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+            REQUIRE_FALSE(search_output.improvements.empty());
+            for (std::size_t i = 0; i < search_output.improvements.size(); ++i) {
+                const SolutionImprovement &improvement = search_output.improvements[i];
+                REQUIRE_TRUE(improvement.path_cost <= improvement.suboptimality_bound * scenario.optimal_cost + 1e-5);
+                REQUIRE_TRUE(improvement.suboptimality_bound <= 3.0);
+                if (i > 0) {
+                    REQUIRE_TRUE(improvement.path_cost <= search_output.improvements[i - 1].path_cost);
+                    REQUIRE_TRUE(improvement.expanded >= search_output.improvements[i - 1].expanded);
+                }
+            }
+            REQUIRE_NEAR(search_output.improvements.back().suboptimality_bound, 1.0, 1e-9);
+            const std::vector<std::size_t> &path = search_output.path_node_ids;
+            double path_cost = 0;
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                REQUIRE_TRUE(graph.are_neighbours(path[i - 1], path[i]));
+                path_cost += distance(graph.get_node(path[i - 1]), graph.get_node(path[i]));
+            }
+            REQUIRE_NEAR(path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+    {
+        // A single weighted search is bounded by its weight
+        Scenario scenario = load_scenario(scenario_path, 1328);
+        ARAStarOptions options;
+        options.initial_weight = 2.0;
+        options.weight_step = 0;
+        SearchOutput search_output =
+            ara_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, options);
+        REQUIRE_TRUE(search_output.path_cost <= 2.0 * scenario.optimal_cost + 1e-5);
+    }
+}
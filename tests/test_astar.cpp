@@ -1,8 +1,10 @@
 // File: test_astar.cpp
 // Test A* on known optimal paths
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <vector>
 
 #include "algorithm/a_star/a_star.h"
 #include "algorithm/common/graph_generator.h"
@@ -31,6 +33,91 @@ int main() {
             a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y});
         REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
     }
+    {
+        // Reusing a search context across queries gives the same results as a fresh one
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        SearchContext context;
+        for (std::size_t i = 0; i < 2; ++i) {
+            for (std::size_t scenario_number : {1328, 0, 500}) {
+                Scenario scenario = load_scenario(scenario_path, scenario_number);
+                SearchContext fresh_context;
+                SearchOutput search_output_fresh = a_star(
+                    graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, fresh_context);
+                SearchOutput search_output =
+                    a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context);
+                REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+                REQUIRE_EQUAL(search_output.expanded, search_output_fresh.expanded);
+                REQUIRE_TRUE(search_output.path_node_ids == search_output_fresh.path_node_ids);
+            }
+        }
+        REQUIRE_EQUAL(context.get_workspace<OctileCost>().capacity(), graph.num_nodes());
+    }
+    {
+        // Bucket queue open list finds the same optimal costs
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        SearchContext context;
+        for (std::size_t scenario_number : {0, 500, 1000, 1328}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            SearchOutput search_output = a_star(graph, {scenario.start_x, scenario.start_y},
+                                                {scenario.goal_x, scenario.goal_y}, context, OpenListType::BucketQueue);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+    {
+        // Policy-based search with the other tie-breaking finds the same optimal costs
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        const GridGraphView view(graph);
+        SearchContext context;
+        for (std::size_t scenario_number : {0, 500, 1000, 1328}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            const std::size_t start_id = graph.get_pos_node_id({scenario.start_x, scenario.start_y});
+            const std::size_t start_index = graph.get_node_index(start_id);
+            const std::size_t goal_id = graph.get_pos_node_id({scenario.goal_x, scenario.goal_y});
+            const std::size_t goal_index = graph.get_node_index(goal_id);
+            const GridOctileHeuristic heuristic(view, goal_index);
+            SearchOutput search_output_high = a_star_search(view, start_index, goal_index, heuristic, context);
+            SearchOutput search_output_low =
+                a_star_search<GridGraphView, GridOctileHeuristic, OctileCost, HeapOpenList, TieBreakLowG>(
+                    view, start_index, goal_index, heuristic, context);
+            REQUIRE_NEAR(search_output_high.path_cost, scenario.optimal_cost, 1e-5);
+            REQUIRE_NEAR(search_output_low.path_cost, scenario.optimal_cost, 1e-5);
+            REQUIRE_TRUE(search_output_low.path_node_ids.front() == start_id);
+        }
+    }
+    {
+        // Searches between node IDs match positional ones, with several sources and targets the path joins the
+        // closest pair
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        SearchContext context;
+        std::vector<std::size_t> start_ids, goal_ids;
+        for (std::size_t scenario_number : {0, 500, 1000}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            const std::size_t start_id = graph.get_pos_node_id({scenario.start_x, scenario.start_y});
+            const std::size_t goal_id = graph.get_pos_node_id({scenario.goal_x, scenario.goal_y});
+            SearchOutput search_output = a_star_nodes(graph, start_id, goal_id, {}, context);
+            SearchOutput search_output_pos =
+                a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+            REQUIRE_TRUE(search_output.path_node_ids == search_output_pos.path_node_ids);
+            start_ids.push_back(start_id);
+            goal_ids.push_back(goal_id);
+        }
+        double min_cost = -1;
+        for (const std::size_t start_id : start_ids) {
+            for (const std::size_t goal_id : goal_ids) {
+                const double cost = a_star_nodes(graph, start_id, goal_id, {}, context).path_cost;
+                if (cost >= 0 && (min_cost < 0 || cost < min_cost)) {
+                    min_cost = cost;
+                }
+            }
+        }
+        SearchOutput search_output = a_star_nodes(graph, start_ids, goal_ids, {}, context);
+        REQUIRE_NEAR(search_output.path_cost, min_cost, 1e-5);
+        REQUIRE_TRUE(std::find(start_ids.begin(), start_ids.end(), search_output.path_node_ids.front()) !=
+                     start_ids.end());
+        REQUIRE_TRUE(std::find(goal_ids.begin(), goal_ids.end(), search_output.path_node_ids.back()) !=
+                     goal_ids.end());
+    }
     {
         Scenario scenario = load_scenario(scenario_path, 1328);
         FlatGraph graph_original = load_flat_graph(scenario_to_map_path(scenario_path));
@@ -0,0 +1,46 @@
+// File: test_bidir_a_star.cpp
+// Test bidirectional A* on known optimal paths
+
+#include <filesystem>
+#include <iostream>
+
+#include "algorithm/bidir_a_star/bidir_a_star.h"
+#include "algorithm/common/graph_generator.h"
+#include "test_macros.h"
+#include "util/file_util.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path scenario_path(__FILE__);
+    scenario_path = scenario_path.replace_filename("battleground.map.scen");
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    {
+        // Optimal costs, with the stitched path running from start to goal over neighbouring nodes
+        SearchContext context;
+        for (std::size_t scenario_number : {0, 500, 1000, 1328}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            SearchOutput search_output = bidir_a_star(graph, {scenario.start_x, scenario.start_y},
+                                                      {scenario.goal_x, scenario.goal_y}, context);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+            const std::vector<std::size_t> &path = search_output.path_node_ids;
+            REQUIRE_EQUAL(path.front(), graph.get_pos_node_id({scenario.start_x, scenario.start_y}));
+            REQUIRE_EQUAL(path.back(), graph.get_pos_node_id({scenario.goal_x, scenario.goal_y}));
+            double path_cost = 0;
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                REQUIRE_TRUE(graph.are_neighbours(path[i - 1], path[i]));
+                path_cost += distance(graph.get_node(path[i - 1]), graph.get_node(path[i]));
+            }
+            REQUIRE_NEAR(path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+    {
+        // Start and goal at the same position
+        Scenario scenario = load_scenario(scenario_path, 0);
+        SearchOutput search_output =
+            bidir_a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.start_x, scenario.start_y});
+        REQUIRE_NEAR(search_output.path_cost, 0, 1e-5);
+        REQUIRE_EQUAL(search_output.path_node_ids.size(), 1u);
+    }
+}
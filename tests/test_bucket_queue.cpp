@@ -0,0 +1,70 @@
+// File: test_bucket_queue.cpp
+// Test the bucket queue against a sorted order
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "test_macros.h"
+#include "util/bucket_queue.h"
+
+using namespace tpl_search;
+
+struct Entry {
+    std::uint64_t key;
+    std::uint64_t tie;
+};
+
+// Lower key first, larger tie value on equal keys
+struct CompareEntry {
+    bool operator()(const Entry &left, const Entry &right) const {
+        return left.key < right.key || (left.key == right.key && left.tie > right.tie);
+    }
+};
+
+int main() {
+    // Monotone use: pops are non-decreasing and pushes are never below the last pop
+    {
+        std::mt19937 rng(0);
+        BucketQueue<Entry, CompareEntry> queue(2);
+        std::vector<Entry> reference;
+        std::uint64_t last_key = 100;
+        queue.push({last_key, 0}, last_key);
+        reference.push_back({last_key, 0});
+        for (std::size_t step = 0; !queue.empty(); ++step) {
+            std::sort(reference.begin(), reference.end(), CompareEntry());
+            Entry top = queue.top();
+            REQUIRE_EQUAL(top.key, reference.front().key);
+            REQUIRE_EQUAL(top.tie, reference.front().tie);
+            queue.pop();
+            reference.erase(reference.begin());
+            last_key = top.key;
+            if (step < 500) {
+                for (std::size_t i = 0; i < 2; ++i) {
+                    Entry entry{last_key + rng() % 20, rng() % 5};
+                    queue.push(entry, entry.key);
+                    reference.push_back(entry);
+                }
+            }
+            REQUIRE_EQUAL(queue.size(), reference.size());
+        }
+        REQUIRE_TRUE(reference.empty());
+    }
+    // Keys below the cursor are still popped first, and clearing allows rebasing
+    {
+        BucketQueue<Entry, CompareEntry> queue(4);
+        queue.push({500, 0}, 500);
+        queue.push({600, 0}, 600);
+        queue.pop();
+        queue.push({10, 0}, 10);
+        REQUIRE_EQUAL(queue.top().key, 10);
+        queue.clear();
+        REQUIRE_TRUE(queue.empty());
+        queue.push({3, 0}, 3);
+        queue.push({3, 1}, 3);
+        REQUIRE_EQUAL(queue.top().tie, 1);
+        queue.pop();
+        REQUIRE_EQUAL(queue.top().tie, 0);
+    }
+}
@@ -46,6 +46,11 @@ int main() {
         graph_original.save(map_to_flat_graph_path(map_path));
         FlatGraph graph;
         graph.load(map_to_flat_graph_path(map_path));
+        // Neighbours are visited in the same order as in the graph built, so searches break ties alike
+        REQUIRE_EQUAL(graph.num_nodes(), graph_original.num_nodes());
+        for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+            REQUIRE_TRUE(graph.get_neighbour_indices(index) == graph_original.get_neighbour_indices(index));
+        }
         const GraphNode *start_node = graph.get_node(scenario.start_y * scenario.width + scenario.start_x);
         std::vector<std::size_t> neighbours;
         graph.get_neighbours(start_node->id, neighbours);
@@ -0,0 +1,80 @@
+// File: test_grid_expansion.cpp
+// Test the batched evaluation of grid moves against the neighbours of the graph
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/common/grid_expansion.h"
+#include "test_macros.h"
+#include "util/file_util.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path map_path(__FILE__);
+    map_path = map_path.replace_filename("battleground.map");
+    FlatGraph graph = load_flat_graph(map_path);
+    const GridGraphView view(graph);
+    {
+        // Move masks hold exactly the neighbours of each node
+        for (std::size_t index = 0; index < graph.num_nodes(); ++index) {
+            std::vector<std::size_t> move_neighbours;
+            for (std::size_t move = 0; move < NUM_GRID_MOVES; ++move) {
+                if (graph.get_move_mask(index) & (1 << move)) {
+                    move_neighbours.push_back(graph.get_move_targets(index)[move]);
+                }
+            }
+            std::vector<std::size_t> neighbours = graph.get_neighbour_indices(index);
+            std::sort(move_neighbours.begin(), move_neighbours.end());
+            std::sort(neighbours.begin(), neighbours.end());
+            REQUIRE_TRUE(move_neighbours == neighbours);
+        }
+    }
+    {
+        // Children match evaluating the neighbours one at a time, with some already generated
+        SearchWorkspace<OctileCost> workspace;
+        const std::size_t goal_index = graph.num_nodes() / 2;
+        const GridOctileHeuristic heuristic(view, goal_index);
+        std::array<GridChild, NUM_GRID_MOVES> children;
+        for (std::size_t index = 0; index < graph.num_nodes(); index += 7) {
+            workspace.reset(graph.num_nodes());
+            const OctileCost g{static_cast<std::int32_t>(index % 13), static_cast<std::int32_t>(index % 11)};
+            std::vector<GridChild> expected;
+            std::size_t i = 0;
+            view.for_each_neighbour(index, [&](std::size_t neighbour_index, const OctileCost &edge_cost) {
+                // Leave some neighbours unseen, and store better, equal or worse paths for the others
+                const OctileCost child_g = g + edge_cost;
+                const OctileCost stored_g[] = {child_g, child_g + CARDINAL_STEP, g, child_g + DIAGONAL_STEP};
+                if (i % 5 < 4) {
+                    workspace.generate(neighbour_index, stored_g[i % 5], NO_PARENT);
+                }
+                if (i % 5 == 4 || child_g < workspace.get_g(neighbour_index)) {
+                    expected.push_back({neighbour_index, child_g, child_g + heuristic(neighbour_index)});
+                }
+                ++i;
+            });
+            const std::size_t num_children = evaluate_grid_moves(view, heuristic, workspace, index, g, children);
+            REQUIRE_EQUAL(num_children, expected.size());
+            for (const GridChild &expected_child : expected) {
+                const auto child = std::find_if(children.begin(), children.begin() + num_children,
+                                                [&](const GridChild &c) { return c.index == expected_child.index; });
+                REQUIRE_TRUE(child != children.begin() + num_children);
+                REQUIRE_TRUE(child->g == expected_child.g);
+                REQUIRE_TRUE(child->f == expected_child.f);
+            }
+        }
+    }
+    {
+        // Constrained nodes outside the set have no moves
+        graph.set_constrained_nodes({graph.get_all_nodes()[0].id});
+        std::array<GridChild, NUM_GRID_MOVES> children;
+        SearchWorkspace<OctileCost> workspace;
+        workspace.reset(graph.num_nodes());
+        const GridOctileHeuristic heuristic(view, 0);
+        REQUIRE_EQUAL(evaluate_grid_moves(view, heuristic, workspace, 1, OctileCost{}, children), 0);
+        REQUIRE_EQUAL(evaluate_grid_moves(view, heuristic, workspace, 0, OctileCost{}, children),
+                      graph.get_neighbour_indices(0).size());
+    }
+}
@@ -142,5 +142,22 @@ int main() {
                 REQUIRE_TRUE(positions.find({x, y}) != positions.end());
             }
         }
+
+        // Cell bounds are rebuilt on load, each covering the cells of its node with one of them as representative
+        for (std::size_t layer_idx = 0; layer_idx < hierarchical_graph.num_layers(); ++layer_idx) {
+            const FlatGraph &layer = hierarchical_graph.get_layer(layer_idx);
+            for (std::size_t index = 0; index < layer.num_nodes(); ++index) {
+                const GraphNode &node = layer.get_all_nodes()[index];
+                const CellBounds &bounds = layer.get_cell_bounds(index);
+                REQUIRE_TRUE(node.represented_positions.find(bounds.representative) !=
+                             node.represented_positions.end());
+                for (const GridPosition &position : node.represented_positions) {
+                    REQUIRE_TRUE(bounds.min_corner.x <= position.x && position.x <= bounds.max_corner.x);
+                    REQUIRE_TRUE(bounds.min_corner.y <= position.y && position.y <= bounds.max_corner.y);
+                    REQUIRE_TRUE(bounds.lower_bound({5, 1}) <= distance(position, {5, 1}) + 1e-9);
+                }
+            }
+        }
+        REQUIRE_NEAR(hierarchical_graph.get_layer(2).get_cell_bounds(0).lower_bound({5, 1}), 2.0, 1e-9);
     }
 }
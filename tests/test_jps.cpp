@@ -0,0 +1,64 @@
+// File: test_jps.cpp
+// Test JPS on known optimal paths
+
+#include <filesystem>
+#include <iostream>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/jps/jps.h"
+#include "test_macros.h"
+#include "util/bit_grid.h"
+#include "util/file_util.h"
+#include "util/map.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path scenario_path(__FILE__);
+    scenario_path = scenario_path.replace_filename("battleground.map.scen");
+    Map map = load_map(scenario_to_map_path(scenario_path));
+    BitGrid grid(map);
+    {
+        // Bits agree with the map, and cells outside of the map are blocked
+        for (std::size_t y = 0; y < map.height; ++y) {
+            for (std::size_t x = 0; x < map.width; ++x) {
+                const auto grid_x = static_cast<std::ptrdiff_t>(x);
+                const auto grid_y = static_cast<std::ptrdiff_t>(y);
+                REQUIRE_EQUAL(grid.is_free(grid_x, grid_y), map.grid_map[y * map.width + x]);
+                REQUIRE_EQUAL((grid.column_bits(grid_x, grid_y) & 1) != 0, map.grid_map[y * map.width + x]);
+            }
+        }
+        REQUIRE_FALSE(grid.is_free(-1, 0));
+        REQUIRE_FALSE(grid.is_free(0, -1));
+        REQUIRE_FALSE(grid.is_free(static_cast<std::ptrdiff_t>(map.width), 0));
+        REQUIRE_FALSE(grid.is_free(0, static_cast<std::ptrdiff_t>(map.height)));
+    }
+    {
+        // Optimal costs on every scenario
+        SearchContext context;
+        for (const Scenario &scenario : load_scenarios(scenario_path)) {
+            SearchOutput search_output =
+                jps(grid, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+    {
+        // The path visits every cell along the way, as in the layer 0 graph
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        for (std::size_t scenario_number : {0, 500, 1000, 1328}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            SearchOutput search_output =
+                jps(grid, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y});
+            const std::vector<std::size_t> &path = search_output.path_node_ids;
+            REQUIRE_EQUAL(path.front(), graph.get_pos_node_id({scenario.start_x, scenario.start_y}));
+            REQUIRE_EQUAL(path.back(), graph.get_pos_node_id({scenario.goal_x, scenario.goal_y}));
+            double path_cost = 0;
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                REQUIRE_TRUE(graph.are_neighbours(path[i - 1], path[i]));
+                path_cost += distance(graph.get_node(path[i - 1]), graph.get_node(path[i]));
+            }
+            REQUIRE_NEAR(path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+}
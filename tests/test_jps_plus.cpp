@@ -0,0 +1,108 @@
+// File: test_jps_plus.cpp
+// Test JPS+ jump tables and search on known optimal paths
+
+#include <filesystem>
+#include <iostream>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/jps/jps.h"
+#include "algorithm/jps/jump_table.h"
+#include "test_macros.h"
+#include "util/bit_grid.h"
+#include "util/file_util.h"
+#include "util/map.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path scenario_path(__FILE__);
+    scenario_path = scenario_path.replace_filename("battleground.map.scen");
+    BitGrid grid(load_map(scenario_to_map_path(scenario_path)));
+    JumpTable jump_table(grid, 1);
+    {
+        // Building over several threads gives the same table
+        JumpTable parallel_jump_table(grid, 4);
+        for (std::size_t y = 0; y < grid.get_height(); ++y) {
+            for (std::size_t x = 0; x < grid.get_width(); ++x) {
+                for (std::size_t direction = 0; direction < NUM_JUMP_DIRECTIONS; ++direction) {
+                    REQUIRE_EQUAL(parallel_jump_table.get_distance(x, y, static_cast<JumpDirection>(direction)),
+                                  jump_table.get_distance(x, y, static_cast<JumpDirection>(direction)));
+                }
+            }
+        }
+    }
+    {
+        // Straight distances stop at the first cell with a forced neighbour, or before the first blocked cell
+        for (std::size_t y = 0; y < grid.get_height(); ++y) {
+            for (std::size_t x = 0; x < grid.get_width(); ++x) {
+                for (const JumpDirection direction : {EAST, WEST, SOUTH, NORTH}) {
+                    const std::ptrdiff_t dx = JUMP_DX[direction];
+                    const std::ptrdiff_t dy = JUMP_DY[direction];
+                    std::ptrdiff_t cx = static_cast<std::ptrdiff_t>(x);
+                    std::ptrdiff_t cy = static_cast<std::ptrdiff_t>(y);
+                    std::int16_t expected = 0;
+                    while (grid.is_free(cx + dx, cy + dy)) {
+                        cx += dx;
+                        cy += dy;
+                        // Side cells are perpendicular to the direction
+                        const auto forced_side = [&](std::ptrdiff_t sx, std::ptrdiff_t sy) {
+                            return grid.is_free(cx + sx, cy + sy) && !grid.is_free(cx + sx - dx, cy + sy - dy);
+                        };
+                        const bool forced = forced_side(dy, dx) || forced_side(-dy, -dx);
+                        if (forced) {
+                            expected = static_cast<std::int16_t>(-expected + 1);
+                            break;
+                        }
+                        --expected;
+                    }
+                    REQUIRE_EQUAL(jump_table.get_distance(x, y, direction), expected);
+                }
+            }
+        }
+    }
+    {
+        // Saved tables load back the same
+        const std::filesystem::path jump_table_path =
+            std::filesystem::temp_directory_path() / "test_jps_plus" / "battleground.jump_table.nop";
+        jump_table.save(jump_table_path);
+        JumpTable loaded_jump_table;
+        loaded_jump_table.load(jump_table_path);
+        std::filesystem::remove_all(jump_table_path.parent_path());
+        REQUIRE_EQUAL(loaded_jump_table.get_width(), jump_table.get_width());
+        REQUIRE_EQUAL(loaded_jump_table.get_height(), jump_table.get_height());
+        for (std::size_t y = 0; y < grid.get_height(); ++y) {
+            for (std::size_t x = 0; x < grid.get_width(); ++x) {
+                REQUIRE_EQUAL(loaded_jump_table.get_distance(x, y, NORTH_WEST),
+                              jump_table.get_distance(x, y, NORTH_WEST));
+            }
+        }
+    }
+    {
+        // Optimal costs on every scenario
+        SearchContext context;
+        for (const Scenario &scenario : load_scenarios(scenario_path)) {
+            SearchOutput search_output = jps_plus(grid, jump_table, {scenario.start_x, scenario.start_y},
+                                                  {scenario.goal_x, scenario.goal_y}, context);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+    {
+        // The path visits every cell along the way, as in the layer 0 graph
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        for (std::size_t scenario_number : {0, 500, 1000, 1328}) {
+            Scenario scenario = load_scenario(scenario_path, scenario_number);
+            SearchOutput search_output =
+                jps_plus(grid, jump_table, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y});
+            const std::vector<std::size_t> &path = search_output.path_node_ids;
+            REQUIRE_EQUAL(path.front(), graph.get_pos_node_id({scenario.start_x, scenario.start_y}));
+            REQUIRE_EQUAL(path.back(), graph.get_pos_node_id({scenario.goal_x, scenario.goal_y}));
+            double path_cost = 0;
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                REQUIRE_TRUE(graph.are_neighbours(path[i - 1], path[i]));
+                path_cost += distance(graph.get_node(path[i - 1]), graph.get_node(path[i]));
+            }
+            REQUIRE_NEAR(path_cost, scenario.optimal_cost, 1e-5);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// File: test_k_controller.cpp
+// Test the choice of K from a target amount of work, on its own and used by PRA*
+
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/pra_star/k_controller.h"
+#include "algorithm/pra_star/pra_star.h"
+#include "test_macros.h"
+#include "test_maps.h"
+
+using namespace tpl_search;
+
+int main() {
+    {
+        // The refinement gets what the starting level search leaves of the target, spread over the levels below
+        KController controller({100, 0}, 8);
+        REQUIRE_EQUAL(controller.get_k(true, 2), std::size_t{8});
+
+        // A first iteration from level 2 costing 20 to start and 160 to refine 8 nodes on 2 levels, 10 per node
+        const std::vector<LevelSearch> first_iteration{{0, 2, 20, 0, 0, 0, false, false},
+                                                       {0, 1, 100, 0, 0, 0, false, false},
+                                                       {0, 0, 60, 0, 0, 0, false, false}};
+        controller.update(first_iteration, 8, true, false);
+        REQUIRE_EQUAL(controller.get_k(true, 2), std::size_t{4});
+        REQUIRE_EQUAL(controller.get_k(true, 1), std::size_t{8});
+        // Later iterations keep the initial K until one has been measured
+        REQUIRE_EQUAL(controller.get_k(false, 2), std::size_t{8});
+
+        // A later iteration with its starting level path kept costs nothing to start
+        const std::vector<LevelSearch> later_iteration{{1, 2, 0, 0, 0, 0, false, true},
+                                                       {1, 1, 100, 0, 0, 0, false, false},
+                                                       {1, 0, 60, 0, 0, 0, false, false}};
+        controller.update(later_iteration, 8, false, false);
+        REQUIRE_EQUAL(controller.get_k(false, 2), std::size_t{5});
+
+        // The last iteration may be shorter than K, only its starting level search is measured
+        const std::vector<LevelSearch> last_iteration{{2, 1, 0, 0, 0, 0, false, true},
+                                                      {2, 0, 1000, 0, 0, 0, false, false}};
+        controller.update(last_iteration, 8, false, true);
+        REQUIRE_EQUAL(controller.get_k(false, 2), std::size_t{5});
+        REQUIRE_EQUAL(controller.get_k(true, 2), std::size_t{4});
+
+        // K stays within its bounds however the target compares to the estimates
+        KController tight_controller({10, 0}, 8);
+        tight_controller.update(first_iteration, 8, true, false);
+        REQUIRE_EQUAL(tight_controller.get_k(true, 2), KController::MIN_K);
+        KController loose_controller({100000, 0}, 8);
+        loose_controller.update(first_iteration, 8, true, false);
+        REQUIRE_EQUAL(loose_controller.get_k(true, 2), KController::MAX_K);
+    }
+    {
+        // Durations are used when the target is a time
+        KController controller({0, 1});
+        const std::vector<LevelSearch> iteration{{0, 1, 1000, 0, 0.25, 0, false, false},
+                                                 {0, 0, 1000, 0, 0.5, 0, false, false}};
+        controller.update(iteration, 8, true, false);
+        REQUIRE_EQUAL(controller.get_k(true, 1), std::size_t{12});
+    }
+    {
+        // PRA* picks K for each iteration, the controller learning over the queries
+        const std::filesystem::path map_path =
+            std::filesystem::temp_directory_path() / "test_k_controller" / "walls.map";
+        write_wall_map(map_path);
+        HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+        std::filesystem::remove_all(map_path.parent_path());
+        const FlatGraph &graph = hierarchical_graph.get_layer(0);
+        SearchContext context;
+        KController controller({200, 0});
+
+        const std::vector<std::pair<GridPosition, GridPosition>> queries{
+            {{0, 0}, {MAP_SIZE - 1, MAP_SIZE - 1}},
+            {{MAP_SIZE - 1, 0}, {0, MAP_SIZE - 1}},
+            {{0, MAP_SIZE / 2}, {MAP_SIZE - 1, MAP_SIZE / 2}},
+        };
+        for (const auto &[start_pos, goal_pos] : queries) {
+            SearchOutput output =
+                pra_star(hierarchical_graph, 0, start_pos, goal_pos, context, {}, nullptr, &controller);
+            REQUIRE_EQUAL(output.path_node_ids.front(), graph.get_pos_node_id(start_pos));
+            REQUIRE_EQUAL(output.path_node_ids.back(), graph.get_pos_node_id(goal_pos));
+            REQUIRE_TRUE(output.level_searches.back().iteration > 0);
+        }
+        REQUIRE_TRUE(controller.get_k(true, 1) != KController::DEFAULT_INITIAL_K);
+    }
+}
@@ -0,0 +1,85 @@
+// File: test_landmarks.cpp
+// Test landmark tables and A* with the ALT heuristic on known optimal paths
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+
+#include "algorithm/a_star/a_star.h"
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/common/landmarks.h"
+#include "test_macros.h"
+#include "util/file_util.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path scenario_path(__FILE__);
+    scenario_path = scenario_path.replace_filename("battleground.map.scen");
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    LandmarkTable landmarks(graph);
+    std::vector<Scenario> scenarios = load_scenarios(scenario_path);
+    {
+        // Distinct landmarks, each at distance zero from itself
+        const std::vector<std::size_t> &landmark_indices = landmarks.get_landmark_indices();
+        REQUIRE_EQUAL(landmark_indices.size(), LandmarkTable::DEFAULT_NUM_LANDMARKS);
+        REQUIRE_EQUAL(landmarks.num_nodes(), graph.num_nodes());
+        for (std::size_t landmark = 0; landmark < landmark_indices.size(); ++landmark) {
+            REQUIRE_TRUE(landmarks.get_distance(landmark, landmark_indices[landmark]) == OctileCost{});
+            for (std::size_t other = 0; other < landmark; ++other) {
+                REQUIRE_TRUE(landmark_indices[landmark] != landmark_indices[other]);
+            }
+        }
+    }
+    {
+        // Bounds are exactly the largest triangle inequality bound over all landmarks and never exceed the optimal cost
+        for (const Scenario &scenario : scenarios) {
+            const std::size_t start_index =
+                graph.get_node_index(graph.get_pos_node_id({scenario.start_x, scenario.start_y}));
+            const std::size_t goal_index =
+                graph.get_node_index(graph.get_pos_node_id({scenario.goal_x, scenario.goal_y}));
+            OctileCost expected;
+            for (std::size_t landmark = 0; landmark < landmarks.get_landmark_indices().size(); ++landmark) {
+                const OctileCost difference =
+                    landmarks.get_distance(landmark, start_index) - landmarks.get_distance(landmark, goal_index);
+                expected = std::max(expected, difference < OctileCost{} ? OctileCost{} - difference : difference);
+            }
+            const OctileCost bound = landmarks.lower_bound(start_index, goal_index);
+            REQUIRE_TRUE(bound == expected);
+            REQUIRE_TRUE(bound.to_double() <= scenario.optimal_cost + 1e-5);
+            REQUIRE_TRUE(landmarks.lower_bound(goal_index, start_index) == bound);
+        }
+    }
+    {
+        // Saved tables load back the same
+        const std::filesystem::path landmarks_path =
+            std::filesystem::temp_directory_path() / "test_landmarks" / "battleground.landmarks.nop";
+        landmarks.save(landmarks_path);
+        LandmarkTable loaded_landmarks;
+        loaded_landmarks.load(landmarks_path);
+        std::filesystem::remove_all(landmarks_path.parent_path());
+        REQUIRE_TRUE(loaded_landmarks.get_landmark_indices() == landmarks.get_landmark_indices());
+        REQUIRE_EQUAL(loaded_landmarks.num_nodes(), landmarks.num_nodes());
+        for (std::size_t index = 0; index < graph.num_nodes(); index += 97) {
+            REQUIRE_TRUE(loaded_landmarks.lower_bound(index, 0) == landmarks.lower_bound(index, 0));
+        }
+    }
+    {
+        // Optimal costs on every scenario, with fewer expansions than the octile heuristic
+        SearchContext context;
+        std::size_t octile_expanded = 0;
+        std::size_t landmark_expanded = 0;
+        for (const Scenario &scenario : scenarios) {
+            SearchOutput search_output = a_star(graph, landmarks, {scenario.start_x, scenario.start_y},
+                                                {scenario.goal_x, scenario.goal_y}, context);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+            landmark_expanded += search_output.expanded;
+            octile_expanded +=
+                a_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, context)
+                    .expanded;
+        }
+        REQUIRE_TRUE(landmark_expanded < octile_expanded);
+    }
+}
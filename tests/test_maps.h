@@ -0,0 +1,46 @@
+// File: test_maps.h
+// Maps generated for tests
+
+#ifndef PRA_TESTS_TEST_MAPS_H
+#define PRA_TESTS_TEST_MAPS_H
+
+#include <filesystem>
+#include <fstream>
+
+// Width and height of the generated map
+constexpr std::size_t MAP_SIZE = 64;
+
+/**
+ * Write a map of walls with alternating gaps, so paths have to wind around them
+ * @param map_path Path to write the map to
+ */
+inline void write_wall_map(const std::filesystem::path &map_path) {
+    std::filesystem::create_directories(map_path.parent_path());
+    std::ofstream map_file(map_path);
+    map_file << "type octile\nheight " << MAP_SIZE << "\nwidth " << MAP_SIZE << "\nmap\n";
+    for (std::size_t y = 0; y < MAP_SIZE; ++y) {
+        for (std::size_t x = 0; x < MAP_SIZE; ++x) {
+            const bool wall = x % 8 == 4 && (x % 16 == 4 ? y < MAP_SIZE - 4 : y >= 4);
+            map_file << (wall ? '@' : '.');
+        }
+        map_file << "\n";
+    }
+}
+
+/**
+ * Write a map split in two halves by a wall without gaps, so no path crosses it
+ * @param map_path Path to write the map to
+ */
+inline void write_split_map(const std::filesystem::path &map_path) {
+    std::filesystem::create_directories(map_path.parent_path());
+    std::ofstream map_file(map_path);
+    map_file << "type octile\nheight " << MAP_SIZE << "\nwidth " << MAP_SIZE << "\nmap\n";
+    for (std::size_t y = 0; y < MAP_SIZE; ++y) {
+        for (std::size_t x = 0; x < MAP_SIZE; ++x) {
+            map_file << (x == MAP_SIZE / 2 ? '@' : '.');
+        }
+        map_file << "\n";
+    }
+}
+
+#endif    // PRA_TESTS_TEST_MAPS_H
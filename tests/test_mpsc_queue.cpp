@@ -0,0 +1,64 @@
+// File: test_mpsc_queue.cpp
+// Test the MPSC queue with several producing threads
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "test_macros.h"
+#include "util/mpsc_queue.h"
+
+using namespace tpl_search;
+
+struct Item {
+    std::size_t producer = 0;
+    std::size_t sequence = 0;
+};
+
+int main() {
+    // Single thread is first in first out
+    {
+        MPSCQueue<std::vector<int>> queue;
+        std::vector<int> value;
+        REQUIRE_FALSE(queue.try_pop(value));
+        queue.push({1, 2});
+        queue.push({3});
+        REQUIRE_TRUE(queue.try_pop(value));
+        REQUIRE_EQUAL(value.size(), 2u);
+        REQUIRE_TRUE(queue.try_pop(value));
+        REQUIRE_EQUAL(value.front(), 3);
+        REQUIRE_FALSE(queue.try_pop(value));
+        // Elements left behind are freed with the queue
+        queue.push({4});
+    }
+    // Every item arrives once, in the order its producer pushed them
+    {
+        constexpr std::size_t NUM_PRODUCERS = 4;
+        constexpr std::size_t NUM_ITEMS = 20000;
+        MPSCQueue<Item> queue;
+        std::vector<std::thread> producers;
+        for (std::size_t producer = 0; producer < NUM_PRODUCERS; ++producer) {
+            producers.emplace_back([&queue, producer]() {
+                for (std::size_t sequence = 0; sequence < NUM_ITEMS; ++sequence) {
+                    queue.push({producer, sequence});
+                }
+            });
+        }
+        std::vector<std::size_t> next_sequence(NUM_PRODUCERS, 0);
+        std::size_t received = 0;
+        Item item;
+        while (received < NUM_PRODUCERS * NUM_ITEMS) {
+            if (!queue.try_pop(item)) {
+                std::this_thread::yield();
+                continue;
+            }
+            REQUIRE_EQUAL(item.sequence, next_sequence[item.producer]);
+            ++next_sequence[item.producer];
+            ++received;
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+        REQUIRE_FALSE(queue.try_pop(item));
+    }
+}
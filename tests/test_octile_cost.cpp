@@ -0,0 +1,50 @@
+// File: test_octile_cost.cpp
+// Test the exact octile cost arithmetic
+
+#include <cmath>
+#include <iostream>
+
+#include "algorithm/common/octile_cost.h"
+#include "test_macros.h"
+
+using namespace tpl_search;
+
+int main() {
+    // Ordering agrees with the real valued cost
+    {
+        for (std::int32_t a1 = 0; a1 < 40; ++a1) {
+            for (std::int32_t b1 = 0; b1 < 40; ++b1) {
+                for (std::int32_t a2 = 0; a2 < 40; ++a2) {
+                    for (std::int32_t b2 = 0; b2 < 40; ++b2) {
+                        OctileCost c1{a1, b1};
+                        OctileCost c2{a2, b2};
+                        if (a1 == a2 && b1 == b2) {
+                            REQUIRE_TRUE(c1 == c2);
+                            REQUIRE_FALSE((c1 < c2));
+                            continue;
+                        }
+                        REQUIRE_TRUE((c1 < c2) == (c1.to_double() < c2.to_double()));
+                        REQUIRE_TRUE((c1 < c2) == (c1.to_fixed() < c2.to_fixed()));
+                    }
+                }
+            }
+        }
+    }
+    // Close values near the encoding limits remain ordered, 46341 / 32768 is just above sqrt(2)
+    {
+        OctileCost c1{46341, 0};
+        OctileCost c2{0, 32768};
+        REQUIRE_TRUE(c2 < c1);
+        REQUIRE_TRUE(c2.to_fixed() < c1.to_fixed());
+        REQUIRE_TRUE(c1.to_fixed() - c2.to_fixed() > 0);
+    }
+    // Octile distance
+    {
+        OctileCost cost = octile_distance({2, 3}, {7, 1});
+        REQUIRE_EQUAL(cost.cardinal, 3);
+        REQUIRE_EQUAL(cost.diagonal, 2);
+        REQUIRE_NEAR(cost.to_double(), distance(GridPosition{2, 3}, GridPosition{7, 1}), 1e-9);
+        REQUIRE_TRUE(octile_distance({5, 5}, {5, 5}) == OctileCost{});
+        REQUIRE_TRUE(CARDINAL_STEP + DIAGONAL_STEP == (OctileCost{1, 1}));
+    }
+}
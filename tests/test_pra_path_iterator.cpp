@@ -0,0 +1,100 @@
+// File: test_pra_path_iterator.cpp
+// Test PRA* refined one segment at a time against the full search
+
+#include <filesystem>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/pra_star/pra_star.h"
+#include "test_macros.h"
+#include "test_maps.h"
+
+using namespace tpl_search;
+
+int main() {
+    const std::filesystem::path map_path =
+        std::filesystem::temp_directory_path() / "test_pra_path_iterator" / "walls.map";
+    write_wall_map(map_path);
+    HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+    std::filesystem::remove_all(map_path.parent_path());
+    const FlatGraph &graph = hierarchical_graph.get_layer(0);
+    SearchContext context;
+
+    const GridPosition start_pos{0, 0};
+    const GridPosition goal_pos{MAP_SIZE - 1, MAP_SIZE - 1};
+    for (const std::size_t k : {0, 2, 4, 8}) {
+        SearchOutput full_output = pra_star(hierarchical_graph, k, start_pos, goal_pos, context);
+
+        // Segments join up into the path of the full search, each one only searched when asked for
+        PRAStarPathIterator path_iterator(hierarchical_graph, k, start_pos, goal_pos, context);
+        std::vector<std::size_t> path{graph.get_pos_node_id(start_pos)};
+        std::size_t first_expanded = 0;
+        while (!path_iterator.is_done()) {
+            REQUIRE_TRUE(path_iterator.next_segment() == SearchStatus::Solved);
+            const std::vector<std::size_t> &segment = path_iterator.get_segment();
+            REQUIRE_EQUAL(segment.front(), path.back());
+            REQUIRE_TRUE(k == 0 || segment.size() <= k);
+            path.insert(path.end(), segment.begin() + 1, segment.end());
+            if (first_expanded == 0) {
+                first_expanded = path_iterator.get_output().expanded;
+            }
+        }
+        REQUIRE_TRUE(path_iterator.get_status() == SearchStatus::Solved);
+        REQUIRE_TRUE(path == full_output.path_node_ids);
+        REQUIRE_EQUAL(path_iterator.get_output().expanded, full_output.expanded);
+        REQUIRE_TRUE(k == 0 || first_expanded < full_output.expanded);
+    }
+
+    // A segment which runs out of budget continues where it stopped on the next call, so one expansion at a time
+    // still reaches the goal along the path of the full search, with partial segments leading from the segment start
+    for (const std::size_t k : {0, 4}) {
+        SearchOutput full_output = pra_star(hierarchical_graph, k, start_pos, goal_pos, context);
+
+        PRAStarPathIterator path_iterator(hierarchical_graph, k, start_pos, goal_pos, context);
+        std::vector<std::size_t> path{graph.get_pos_node_id(start_pos)};
+        std::size_t num_in_progress = 0;
+        while (!path_iterator.is_done()) {
+            const SearchStatus segment_status = path_iterator.next_segment({1, 0});
+            const std::vector<std::size_t> &segment = path_iterator.get_segment();
+            REQUIRE_EQUAL(segment.front(), path.back());
+            if (segment_status == SearchStatus::InProgress) {
+                ++num_in_progress;
+            } else {
+                REQUIRE_TRUE(segment_status == SearchStatus::Solved);
+                path.insert(path.end(), segment.begin() + 1, segment.end());
+            }
+        }
+        REQUIRE_TRUE(path_iterator.get_status() == SearchStatus::Solved);
+        REQUIRE_EQUAL(path.back(), graph.get_pos_node_id(goal_pos));
+        REQUIRE_TRUE(path == full_output.path_node_ids);
+        REQUIRE_EQUAL(path_iterator.get_output().expanded, full_output.expanded);
+        REQUIRE_TRUE(num_in_progress > 0);
+    }
+
+    // Endpoints on either side of an unbroken wall end the search without a path, whether they are far apart or
+    // next to each other
+    const std::filesystem::path split_map_path =
+        std::filesystem::temp_directory_path() / "test_pra_path_iterator" / "split.map";
+    write_split_map(split_map_path);
+    HierarchicalGraph split_graph(load_flat_graph(split_map_path));
+    std::filesystem::remove_all(split_map_path.parent_path());
+    for (const auto &[split_start_pos, split_goal_pos] :
+         {std::make_pair(GridPosition{0, 0}, GridPosition{MAP_SIZE - 1, MAP_SIZE - 1}),
+          std::make_pair(GridPosition{MAP_SIZE / 2 - 1, 8}, GridPosition{MAP_SIZE / 2 + 1, 8})}) {
+        for (const std::size_t k : {0, 4}) {
+            PRAStarPathIterator split_iterator(split_graph, k, split_start_pos, split_goal_pos, context);
+            while (!split_iterator.is_done()) {
+                REQUIRE_TRUE(split_iterator.next_segment() != SearchStatus::InProgress);
+            }
+            REQUIRE_TRUE(split_iterator.get_status() == SearchStatus::NoPath);
+            REQUIRE_TRUE(split_iterator.get_segment().empty());
+
+            SearchOutput split_output = pra_star(split_graph, k, split_start_pos, split_goal_pos, context);
+            REQUIRE_TRUE(split_output.path_node_ids.empty());
+            REQUIRE_EQUAL(split_output.path_cost, -1.0);
+            REQUIRE_FALSE(split_output.is_partial);
+        }
+    }
+}
@@ -0,0 +1,177 @@
+// File: test_pra_star.cpp
+// Test the full path and the level searches reported by PRA*
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/common/octile_cost.h"
+#include "algorithm/pra_star/abstract_path_cache.h"
+#include "algorithm/pra_star/pra_star.h"
+#include "test_macros.h"
+#include "test_maps.h"
+
+using namespace tpl_search;
+
+int main() {
+    const std::filesystem::path map_path = std::filesystem::temp_directory_path() / "test_pra_star" / "walls.map";
+    write_wall_map(map_path);
+    HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+    std::filesystem::remove_all(map_path.parent_path());
+    const FlatGraph &graph = hierarchical_graph.get_layer(0);
+    SearchContext context;
+
+    const GridPosition start_pos{0, 0};
+    const GridPosition goal_pos{MAP_SIZE - 1, MAP_SIZE - 1};
+    for (const std::size_t k : {0, 4, 8}) {
+        SearchOutput output = pra_star(hierarchical_graph, k, start_pos, goal_pos, context);
+
+        // The path is every grid cell from the start to the goal, each one step from the last
+        const std::vector<std::size_t> &path = output.path_node_ids;
+        REQUIRE_EQUAL(path.front(), graph.get_pos_node_id(start_pos));
+        REQUIRE_EQUAL(path.back(), graph.get_pos_node_id(goal_pos));
+        double path_cost = 0;
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            const GridPosition &from = *graph.get_node(path[i - 1])->represented_positions.begin();
+            const GridPosition &to = *graph.get_node(path[i])->represented_positions.begin();
+            REQUIRE_TRUE(from != to && octile_distance(from, to).to_double() < 1.5);
+            path_cost += octile_distance(from, to).to_double();
+        }
+        REQUIRE_TRUE(std::abs(path_cost - output.path_cost) < 1e-6);
+
+        // Level searches add up to the totals, each iteration searches down to the grid with the levels below its
+        // starting level constrained to a corridor
+        REQUIRE_FALSE(output.level_searches.empty());
+        std::size_t expanded = 0;
+        std::size_t generated = 0;
+        std::size_t num_iterations = 0;
+        std::size_t num_reused = 0;
+        for (std::size_t i = 0; i < output.level_searches.size(); ++i) {
+            const LevelSearch &level_search = output.level_searches[i];
+            expanded += level_search.expanded;
+            generated += level_search.generated;
+            REQUIRE_FALSE(level_search.is_cache_hit);
+            const bool is_first = i == 0 || output.level_searches[i - 1].level == 0;
+            if (is_first) {
+                REQUIRE_EQUAL(level_search.iteration, num_iterations);
+                REQUIRE_EQUAL(level_search.corridor_size, std::size_t{0});
+                ++num_iterations;
+            } else {
+                REQUIRE_EQUAL(level_search.iteration, output.level_searches[i - 1].iteration);
+                REQUIRE_EQUAL(level_search.level + 1, output.level_searches[i - 1].level);
+                REQUIRE_TRUE(level_search.corridor_size > 0);
+            }
+            // Only the starting level path is kept between iterations, without searching
+            if (level_search.is_reused) {
+                REQUIRE_TRUE(is_first && level_search.iteration > 0);
+                REQUIRE_EQUAL(level_search.expanded, std::size_t{0});
+                ++num_reused;
+            }
+        }
+        REQUIRE_EQUAL(output.level_searches.back().level, std::size_t{0});
+        REQUIRE_EQUAL(expanded, output.expanded);
+        REQUIRE_EQUAL(generated, output.generated);
+        REQUIRE_TRUE(k == 0 ? num_iterations == 1 : num_iterations > 1);
+        REQUIRE_TRUE(k == 0 ? num_reused == 0 : num_reused > 0);
+    }
+
+    // Abstract paths found in the cache are reported as hits without any expansions
+    AbstractPathCache path_cache;
+    pra_star(hierarchical_graph, 0, start_pos, goal_pos, context, {}, &path_cache);
+    SearchOutput cached_output = pra_star(hierarchical_graph, 0, start_pos, goal_pos, context, {}, &path_cache);
+    REQUIRE_TRUE(cached_output.level_searches.front().is_cache_hit);
+    REQUIRE_EQUAL(cached_output.level_searches.front().expanded, std::size_t{0});
+
+    // Searches cut short by the budget are still reported
+    SearchOutput partial_output = pra_star(hierarchical_graph, 4, start_pos, goal_pos, context, {1, 0});
+    REQUIRE_TRUE(partial_output.is_partial);
+    REQUIRE_FALSE(partial_output.level_searches.empty());
+
+    // Windows refined in parallel join into one grid path, a single window finds the same path cost as PRA* without
+    // truncation on this map
+    std::vector<SearchContext> contexts;
+    const SearchOutput sequential_output = pra_star(hierarchical_graph, 0, start_pos, goal_pos, context);
+    for (const std::size_t num_threads : {1, 4}) {
+        SearchOutput output = pra_star_parallel(hierarchical_graph, start_pos, goal_pos, num_threads, contexts);
+        const std::vector<std::size_t> &path = output.path_node_ids;
+        REQUIRE_EQUAL(path.front(), graph.get_pos_node_id(start_pos));
+        REQUIRE_EQUAL(path.back(), graph.get_pos_node_id(goal_pos));
+        double path_cost = 0;
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            const GridPosition &from = *graph.get_node(path[i - 1])->represented_positions.begin();
+            const GridPosition &to = *graph.get_node(path[i])->represented_positions.begin();
+            REQUIRE_TRUE(from != to && octile_distance(from, to).to_double() < 1.5);
+            path_cost += octile_distance(from, to).to_double();
+        }
+        REQUIRE_TRUE(std::abs(path_cost - output.path_cost) < 1e-6);
+
+        std::size_t expanded = 0;
+        std::size_t num_windows = 0;
+        for (const LevelSearch &level_search : output.level_searches) {
+            expanded += level_search.expanded;
+            num_windows = std::max(num_windows, level_search.iteration + 1);
+        }
+        REQUIRE_EQUAL(expanded, output.expanded);
+        if (num_threads == 1) {
+            REQUIRE_EQUAL(num_windows, std::size_t{1});
+            REQUIRE_TRUE(std::abs(output.path_cost - sequential_output.path_cost) < 1e-6);
+        } else {
+            // Each seam searched again costs at most a diagonal step over PRA* without truncation on this map
+            REQUIRE_TRUE(num_windows > 1 && num_windows <= num_threads);
+            REQUIRE_TRUE(output.path_cost <=
+                         sequential_output.path_cost + static_cast<double>(num_windows - 1) * std::sqrt(2.0) + 1e-6);
+        }
+    }
+
+    // The first iteration starts from the lowest level where the abstract start and goal are within
+    // STARTING_LEVEL_HOPS, the same level as counting the hops on every level in full
+    auto count_hops = [&](std::size_t level, std::size_t start_index, std::size_t goal_index) {
+        const FlatGraph &layer = hierarchical_graph.get_layer(level);
+        std::vector<std::size_t> hops(layer.num_nodes(), layer.num_nodes());
+        hops[start_index] = 0;
+        std::vector<std::size_t> queue{start_index};
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            for (const std::size_t neighbour_index : layer.get_neighbour_indices(queue[i])) {
+                if (hops[neighbour_index] == layer.num_nodes()) {
+                    hops[neighbour_index] = hops[queue[i]] + 1;
+                    queue.push_back(neighbour_index);
+                }
+            }
+        }
+        return hops[goal_index];
+    };
+    auto get_starting_level = [&](const GridPosition &query_start_pos, const GridPosition &query_goal_pos) {
+        PRAStarPathIterator path_iterator(hierarchical_graph, 1, query_start_pos, query_goal_pos, context);
+        REQUIRE_TRUE(path_iterator.next_segment() != SearchStatus::NoPath);
+        return path_iterator.get_output().level_searches.front().level;
+    };
+    auto get_unpruned_level = [&](const GridPosition &query_start_pos, const GridPosition &query_goal_pos) {
+        std::size_t start_index = graph.get_node_index(graph.get_pos_node_id(query_start_pos));
+        std::size_t goal_index = graph.get_node_index(graph.get_pos_node_id(query_goal_pos));
+        for (std::size_t level = 0;; ++level) {
+            if (level + 1 == hierarchical_graph.num_layers() ||
+                count_hops(level, start_index, goal_index) <= STARTING_LEVEL_HOPS) {
+                return level;
+            }
+            start_index = hierarchical_graph.get_parent_index(level, start_index);
+            goal_index = hierarchical_graph.get_parent_index(level, goal_index);
+        }
+    };
+    // A short query is searched on the grid alone, a long one starts higher but no higher than the first level within
+    // the hop limit
+    REQUIRE_EQUAL(get_starting_level({2, 2}, {2, 4}), std::size_t{0});
+    const std::size_t long_level = get_starting_level(start_pos, goal_pos);
+    REQUIRE_TRUE(long_level > 0);
+    REQUIRE_EQUAL(long_level, get_unpruned_level(start_pos, goal_pos));
+    for (std::size_t start_index = 0; start_index < graph.num_nodes(); start_index += 97) {
+        for (std::size_t goal_index = 0; goal_index < graph.num_nodes(); goal_index += 89) {
+            const GridPosition &query_start_pos = graph.get_cell_bounds(start_index).representative;
+            const GridPosition &query_goal_pos = graph.get_cell_bounds(goal_index).representative;
+            REQUIRE_EQUAL(get_starting_level(query_start_pos, query_goal_pos),
+                          get_unpruned_level(query_start_pos, query_goal_pos));
+        }
+    }
+}
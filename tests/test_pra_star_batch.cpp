@@ -0,0 +1,82 @@
+// File: test_pra_star_batch.cpp
+// Test the abstract level searches shared between PRA* queries, on their own and by batched PRA*
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/pra_star/level_search_memo.h"
+#include "algorithm/pra_star/pra_star.h"
+#include "test_macros.h"
+#include "test_maps.h"
+
+using namespace tpl_search;
+
+int main() {
+    {
+        // A level search is only found again on the same level, between the same nodes, in the same corridor
+        LevelSearchMemo memo;
+        std::vector<std::size_t> path;
+        REQUIRE_FALSE(memo.find(1, 3, 7, {}, path));
+        memo.insert(1, {}, {3, 5, 7});
+        memo.insert(1, {10, 11}, {3, 4, 7});
+        REQUIRE_TRUE(memo.find(1, 3, 7, {}, path));
+        REQUIRE_TRUE(path == std::vector<std::size_t>({3, 5, 7}));
+        REQUIRE_TRUE(memo.find(1, 3, 7, {10, 11}, path));
+        REQUIRE_TRUE(path == std::vector<std::size_t>({3, 4, 7}));
+        REQUIRE_FALSE(memo.find(1, 3, 7, {10}, path));
+        REQUIRE_FALSE(memo.find(2, 3, 7, {}, path));
+        REQUIRE_FALSE(memo.find(1, 7, 3, {}, path));
+        REQUIRE_EQUAL(memo.size(), std::size_t{2});
+        REQUIRE_EQUAL(memo.get_hits(), std::size_t{2});
+        REQUIRE_EQUAL(memo.get_misses(), std::size_t{4});
+        memo.clear();
+        REQUIRE_FALSE(memo.find(1, 3, 7, {}, path));
+    }
+    {
+        // A group moving to the same goal shares its abstract searches, every query still gets the path pra_star
+        // finds for it alone
+        const std::filesystem::path map_path =
+            std::filesystem::temp_directory_path() / "test_pra_star_batch" / "walls.map";
+        write_wall_map(map_path);
+        HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+        std::filesystem::remove_all(map_path.parent_path());
+        SearchContext context;
+
+        std::vector<std::pair<GridPosition, GridPosition>> queries;
+        for (std::size_t y = 0; y < 4; ++y) {
+            for (std::size_t x = 0; x < 4; ++x) {
+                queries.push_back({{x, y}, {MAP_SIZE - 1, MAP_SIZE - 1}});
+            }
+        }
+        queries.push_back({{MAP_SIZE - 1, 0}, {0, MAP_SIZE - 1}});
+        queries.push_back({{2, 2}, {2, 4}});
+
+        for (const std::size_t k : {0, 8}) {
+            const std::vector<SearchOutput> outputs = pra_star_batch(hierarchical_graph, k, queries, context);
+            REQUIRE_EQUAL(outputs.size(), queries.size());
+            std::size_t batch_expanded = 0, alone_expanded = 0, num_shared = 0;
+            for (std::size_t q = 0; q < queries.size(); ++q) {
+                const SearchOutput alone =
+                    pra_star(hierarchical_graph, k, queries[q].first, queries[q].second, context);
+                REQUIRE_TRUE(outputs[q].path_node_ids == alone.path_node_ids);
+                REQUIRE_NEAR(outputs[q].path_cost, alone.path_cost, 1e-9);
+                batch_expanded += outputs[q].expanded;
+                alone_expanded += alone.expanded;
+                num_shared += std::count_if(outputs[q].level_searches.begin(), outputs[q].level_searches.end(),
+                                            [](const LevelSearch &level_search) {
+                                                return level_search.is_cache_hit;
+                                            });
+                // Grid searches are never shared
+                for (const LevelSearch &level_search : outputs[q].level_searches) {
+                    REQUIRE_TRUE(level_search.level > 0 || !level_search.is_cache_hit);
+                }
+            }
+            REQUIRE_TRUE(num_shared > 0);
+            REQUIRE_TRUE(batch_expanded < alone_expanded);
+        }
+    }
+}
@@ -0,0 +1,107 @@
+// File: test_search_budget.cpp
+// Test searches stopped by their budget, resumed A* and partial PRA* paths
+
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "algorithm/a_star/a_star.h"
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/pra_star/pra_star.h"
+#include "test_macros.h"
+#include "test_maps.h"
+#include "util/file_util.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+/**
+ * Check a path runs over neighbouring nodes from the start
+ * @param graph The graph the path is on
+ * @param path Node IDs of the path
+ * @param start_pos The starting position
+ * @return Cost of the path
+ */
+double check_path(const FlatGraph &graph, const std::vector<std::size_t> &path, const GridPosition &start_pos) {
+    REQUIRE_TRUE(!path.empty());
+    REQUIRE_EQUAL(path.front(), graph.get_pos_node_id(start_pos));
+    double path_cost = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        REQUIRE_TRUE(graph.are_neighbours(path[i - 1], path[i]));
+        path_cost += distance(graph.get_node(path[i - 1]), graph.get_node(path[i]));
+    }
+    return path_cost;
+}
+
+int main() {
+    {
+        // A* run in slices matches a single run, with partial paths toward the goal in between
+        std::filesystem::path scenario_path(__FILE__);
+        scenario_path = scenario_path.replace_filename("battleground.map.scen");
+        FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+        std::vector<Scenario> scenarios = load_scenarios(scenario_path);
+        SearchContext context;
+        for (std::size_t scenario_number = 0; scenario_number < scenarios.size(); scenario_number += 100) {
+            const Scenario &scenario = scenarios[scenario_number];
+            const GridPosition start_pos{scenario.start_x, scenario.start_y};
+            const GridPosition goal_pos{scenario.goal_x, scenario.goal_y};
+            SearchOutput full_output = a_star(graph, start_pos, goal_pos, context);
+
+            GridAStarSearch search = make_grid_a_star_search(graph, start_pos, goal_pos, context);
+            std::size_t num_runs = 0;
+            while (search.run({100, 0}) == SearchStatus::InProgress) {
+                ++num_runs;
+                SearchOutput partial_output = search.get_output();
+                REQUIRE_TRUE(partial_output.is_partial);
+                REQUIRE_EQUAL(partial_output.expanded, 100 * num_runs);
+                REQUIRE_NEAR(check_path(graph, partial_output.path_node_ids, start_pos), partial_output.path_cost,
+                             1e-5);
+            }
+            REQUIRE_TRUE(search.get_status() == SearchStatus::Solved);
+            SearchOutput search_output = search.get_output();
+            REQUIRE_FALSE(search_output.is_partial);
+            REQUIRE_EQUAL(search_output.expanded, full_output.expanded);
+            REQUIRE_EQUAL(search_output.path_node_ids.back(), graph.get_pos_node_id(goal_pos));
+            REQUIRE_NEAR(check_path(graph, search_output.path_node_ids, start_pos), scenario.optimal_cost, 1e-5);
+            REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+        }
+
+        // Budgets which are never reached don't change the result
+        const Scenario &scenario = scenarios.back();
+        const GridPosition start_pos{scenario.start_x, scenario.start_y};
+        const GridPosition goal_pos{scenario.goal_x, scenario.goal_y};
+        SearchOutput search_output = a_star(graph, start_pos, goal_pos, {graph.num_nodes(), 1000}, context);
+        REQUIRE_FALSE(search_output.is_partial);
+        REQUIRE_NEAR(search_output.path_cost, scenario.optimal_cost, 1e-5);
+    }
+    {
+        // PRA* keeps the completed iterations when it runs out, and continues from the end of its partial path
+        const std::filesystem::path map_path =
+            std::filesystem::temp_directory_path() / "test_search_budget" / "walls.map";
+        write_wall_map(map_path);
+        HierarchicalGraph hierarchical_graph(load_flat_graph(map_path));
+        std::filesystem::remove_all(map_path.parent_path());
+        const FlatGraph &graph = hierarchical_graph.get_layer(0);
+        SearchContext context;
+
+        const GridPosition start_pos{0, 0};
+        const GridPosition goal_pos{MAP_SIZE - 1, MAP_SIZE - 1};
+        SearchOutput full_output = pra_star(hierarchical_graph, 4, start_pos, goal_pos, context);
+        REQUIRE_FALSE(full_output.is_partial);
+        REQUIRE_EQUAL(full_output.path_node_ids.back(), graph.get_pos_node_id(goal_pos));
+        REQUIRE_NEAR(check_path(graph, full_output.path_node_ids, start_pos), full_output.path_cost, 1e-5);
+
+        GridPosition current_pos = start_pos;
+        std::size_t num_runs = 0;
+        while (current_pos != goal_pos) {
+            REQUIRE_TRUE(++num_runs < 1000);
+            SearchOutput search_output = pra_star(hierarchical_graph, 4, current_pos, goal_pos, context, {200, 0});
+            REQUIRE_TRUE(search_output.expanded <= 200);
+            check_path(graph, search_output.path_node_ids, current_pos);
+            REQUIRE_TRUE(search_output.is_partial || search_output.path_node_ids.back() ==
+                                                         graph.get_pos_node_id(goal_pos));
+            current_pos = *graph.get_node(search_output.path_node_ids.back())->represented_positions.begin();
+        }
+        REQUIRE_TRUE(num_runs > 1);
+    }
+}
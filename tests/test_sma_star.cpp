@@ -0,0 +1,52 @@
+// File: test_sma_star.cpp
+// Test memory-bounded SMA* search on known optimal paths
+
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "algorithm/common/graph_generator.h"
+#include "algorithm/sma_star/sma_star.h"
+#include "test_macros.h"
+#include "util/file_util.h"
+#include "util/scenario.h"
+
+using namespace tpl_search;
+
+int main() {
+    std::filesystem::path scenario_path(__FILE__);
+    scenario_path = scenario_path.replace_filename("battleground.map.scen");
+    FlatGraph graph = load_flat_graph(scenario_to_map_path(scenario_path));
+    std::vector<Scenario> scenarios = load_scenarios(scenario_path);
+    for (std::size_t scenario_number = 0; scenario_number < scenarios.size(); scenario_number += 100) {
+        const Scenario &scenario = scenarios[scenario_number];
+        const GridPosition start_pos{scenario.start_x, scenario.start_y};
+        const GridPosition goal_pos{scenario.goal_x, scenario.goal_y};
+
+        // Without a cap the search is optimal and holds at most one node per graph node
+        SearchOutput unbounded = sma_star(graph, start_pos, goal_pos, 0);
+        REQUIRE_NEAR(unbounded.path_cost, scenario.optimal_cost, 1e-5);
+        REQUIRE_TRUE(unbounded.peak_nodes <= graph.num_nodes());
+
+        // Dropping nodes keeps the path optimal within the cap
+        const std::size_t max_nodes = unbounded.peak_nodes * 3 / 4 + 1;
+        SearchOutput bounded = sma_star(graph, start_pos, goal_pos, max_nodes);
+        REQUIRE_NEAR(bounded.path_cost, scenario.optimal_cost, 1e-5);
+        REQUIRE_TRUE(bounded.peak_nodes <= max_nodes);
+        const std::vector<std::size_t> &path = bounded.path_node_ids;
+        REQUIRE_EQUAL(path.front(), graph.get_pos_node_id(start_pos));
+        REQUIRE_EQUAL(path.back(), graph.get_pos_node_id(goal_pos));
+        double path_cost = 0;
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            REQUIRE_TRUE(graph.are_neighbours(path[i - 1], path[i]));
+            path_cost += distance(graph.get_node(path[i - 1]), graph.get_node(path[i]));
+        }
+        REQUIRE_NEAR(path_cost, scenario.optimal_cost, 1e-5);
+    }
+    // A cap too small to hold any path to the goal
+    const Scenario &scenario = scenarios.back();
+    SearchOutput search_output =
+        sma_star(graph, {scenario.start_x, scenario.start_y}, {scenario.goal_x, scenario.goal_y}, 2);
+    REQUIRE_TRUE(search_output.path_node_ids.empty());
+    REQUIRE_TRUE(search_output.peak_nodes <= 2);
+}